@@ -8,58 +8,58 @@
 
 void ActionObject::registerMetaTypes(void)
 {
-    qRegisterMetaType <Actions::Status>                         ("statusAction");
-    qRegisterMetaType <Actions::PowerOnStatus>                  ("powerOnStatusAction");
-    qRegisterMetaType <Actions::SwitchType>                     ("switchTypeAction");
-    qRegisterMetaType <Actions::SwitchMode>                     ("switchModeAction");
-    qRegisterMetaType <Actions::Level>                          ("levelAction");
-    qRegisterMetaType <Actions::AnalogOutput>                   ("analogOutputAction");
-    qRegisterMetaType <Actions::CoverStatus>                    ("coverStatusAction");
-    qRegisterMetaType <Actions::CoverPosition>                  ("coverPositionAction");
-    qRegisterMetaType <Actions::CoverTilt>                      ("coverTiltAction");
-    qRegisterMetaType <Actions::Thermostat>                     ("thermostatAction");
-    qRegisterMetaType <Actions::FanMode>                        ("fanModeAction");
-    qRegisterMetaType <Actions::DisplayMode>                    ("displayModeAction");
-    qRegisterMetaType <Actions::ColorHS>                        ("colorHSAction");
-    qRegisterMetaType <Actions::ColorXY>                        ("colorXYAction");
-    qRegisterMetaType <Actions::ColorTemperature>               ("colorTemperatureAction");
-    qRegisterMetaType <Actions::OccupancyTimeout>               ("occupancyTimeoutAction");
-
-    qRegisterMetaType <ActionsIAS::Warning>                     ("iasWarningAction");
-
-    qRegisterMetaType <ActionsLUMI::PresenceSensor>             ("lumiPresenceSensorAction");
-    qRegisterMetaType <ActionsLUMI::ButtonMode>                 ("lumiButtonModeAction");
-    qRegisterMetaType <ActionsLUMI::OperationMode>              ("lumiOperationModeAction");
-    qRegisterMetaType <ActionsLUMI::IndicatorMode>              ("lumiIndicatorModeAction");
-    qRegisterMetaType <ActionsLUMI::SwitchMode>                 ("lumiSwitchModeAction");
-    qRegisterMetaType <ActionsLUMI::SwitchStatusMemory>         ("lumiSwitchStatusMemoryAction");
-    qRegisterMetaType <ActionsLUMI::LightStatusMemory>          ("lumiLightStatusMemoryAction");
-    qRegisterMetaType <ActionsLUMI::CoverPosition>              ("lumiCoverPositionAction");
-    qRegisterMetaType <ActionsLUMI::VibrationSensitivity>       ("lumiVibrationSensitivityAction");
-
-    qRegisterMetaType <ActionsTUYA::DataPoints>                 ("tuyaDataPointsAction");
-    qRegisterMetaType <ActionsTUYA::HolidayThermostatProgram>   ("tuyaHolidayThermostatProgramAction");
-    qRegisterMetaType <ActionsTUYA::DailyThermostatProgram>     ("tuyaDailyThermostatProgramAction");
-    qRegisterMetaType <ActionsTUYA::MoesThermostatProgram>      ("tuyaMoesThermostatProgramAction");
-    qRegisterMetaType <ActionsTUYA::CoverMotor>                 ("tuyaCoverMotorAction");
-    qRegisterMetaType <ActionsTUYA::CoverSwitch>                ("tuyaCoverSwitchAction");
-    qRegisterMetaType <ActionsTUYA::ChildLock>                  ("tuyaChildLockAction");
-    qRegisterMetaType <ActionsTUYA::OperationMode>              ("tuyaOperationModeAction");
-    qRegisterMetaType <ActionsTUYA::IndicatorMode>              ("tuyaIndicatorModeAction");
-    qRegisterMetaType <ActionsTUYA::SwitchType>                 ("tuyaSwitchTypeAction");
-    qRegisterMetaType <ActionsTUYA::PowerOnStatus>              ("tuyaPowerOnStatusAction");
-
-    qRegisterMetaType <ActionsEfekta::ReportingDelay>           ("efektaReportingDelayAction");
-    qRegisterMetaType <ActionsEfekta::TemperatureSettings>      ("efektaTemperatureSettingsAction");
-    qRegisterMetaType <ActionsEfekta::HumiditySettings>         ("efektaHumiditySettingsAction");
-    qRegisterMetaType <ActionsEfekta::CO2Settings>              ("efektaCO2SettingsAction");
-    qRegisterMetaType <ActionsEfekta::PMSensor>                 ("efektaPMSensorAction");
-    qRegisterMetaType <ActionsEfekta::VOCSensor>                ("efektaVOCSensorAction");
-
-    qRegisterMetaType <ActionsPTVO::ChangePattern>              ("ptvoChangePatternAction");
-    qRegisterMetaType <ActionsPTVO::Count>                      ("ptvoCountAction");
-    qRegisterMetaType <ActionsPTVO::Pattern>                    ("ptvoPatternAction");
-    qRegisterMetaType <ActionsPTVO::SerialData>                 ("ptvoSerialDataAction");
+    Registry <ActionObject>::add <Actions::Status>                       ("status");
+    Registry <ActionObject>::add <Actions::PowerOnStatus>                ("powerOnStatus");
+    Registry <ActionObject>::add <Actions::SwitchType>                   ("switchType");
+    Registry <ActionObject>::add <Actions::SwitchMode>                   ("switchMode");
+    Registry <ActionObject>::add <Actions::Level>                        ("level");
+    Registry <ActionObject>::add <Actions::AnalogOutput>                 ("analogOutput");
+    Registry <ActionObject>::add <Actions::CoverStatus>                  ("coverStatus");
+    Registry <ActionObject>::add <Actions::CoverPosition>                ("coverPosition");
+    Registry <ActionObject>::add <Actions::CoverTilt>                    ("coverTilt");
+    Registry <ActionObject>::add <Actions::Thermostat>                   ("thermostat");
+    Registry <ActionObject>::add <Actions::FanMode>                      ("fanMode");
+    Registry <ActionObject>::add <Actions::DisplayMode>                  ("displayMode");
+    Registry <ActionObject>::add <Actions::ColorHS>                      ("colorHS");
+    Registry <ActionObject>::add <Actions::ColorXY>                      ("colorXY");
+    Registry <ActionObject>::add <Actions::ColorTemperature>             ("colorTemperature");
+    Registry <ActionObject>::add <Actions::OccupancyTimeout>             ("occupancyTimeout");
+
+    Registry <ActionObject>::add <ActionsIAS::Warning>                   ("iasWarning");
+
+    Registry <ActionObject>::add <ActionsLUMI::PresenceSensor>           ("lumiPresenceSensor");
+    Registry <ActionObject>::add <ActionsLUMI::ButtonMode>               ("lumiButtonMode");
+    Registry <ActionObject>::add <ActionsLUMI::OperationMode>            ("lumiOperationMode");
+    Registry <ActionObject>::add <ActionsLUMI::IndicatorMode>            ("lumiIndicatorMode");
+    Registry <ActionObject>::add <ActionsLUMI::SwitchMode>               ("lumiSwitchMode");
+    Registry <ActionObject>::add <ActionsLUMI::SwitchStatusMemory>       ("lumiSwitchStatusMemory");
+    Registry <ActionObject>::add <ActionsLUMI::LightStatusMemory>        ("lumiLightStatusMemory");
+    Registry <ActionObject>::add <ActionsLUMI::CoverPosition>            ("lumiCoverPosition");
+    Registry <ActionObject>::add <ActionsLUMI::VibrationSensitivity>     ("lumiVibrationSensitivity");
+
+    Registry <ActionObject>::add <ActionsTUYA::DataPoints>               ("tuyaDataPoints");
+    Registry <ActionObject>::add <ActionsTUYA::HolidayThermostatProgram> ("tuyaHolidayThermostatProgram");
+    Registry <ActionObject>::add <ActionsTUYA::DailyThermostatProgram>   ("tuyaDailyThermostatProgram");
+    Registry <ActionObject>::add <ActionsTUYA::MoesThermostatProgram>    ("tuyaMoesThermostatProgram");
+    Registry <ActionObject>::add <ActionsTUYA::CoverMotor>               ("tuyaCoverMotor");
+    Registry <ActionObject>::add <ActionsTUYA::CoverSwitch>              ("tuyaCoverSwitch");
+    Registry <ActionObject>::add <ActionsTUYA::ChildLock>                ("tuyaChildLock");
+    Registry <ActionObject>::add <ActionsTUYA::OperationMode>            ("tuyaOperationMode");
+    Registry <ActionObject>::add <ActionsTUYA::IndicatorMode>            ("tuyaIndicatorMode");
+    Registry <ActionObject>::add <ActionsTUYA::SwitchType>               ("tuyaSwitchType");
+    Registry <ActionObject>::add <ActionsTUYA::PowerOnStatus>            ("tuyaPowerOnStatus");
+
+    Registry <ActionObject>::add <ActionsEfekta::ReportingDelay>         ("efektaReportingDelay");
+    Registry <ActionObject>::add <ActionsEfekta::TemperatureSettings>    ("efektaTemperatureSettings");
+    Registry <ActionObject>::add <ActionsEfekta::HumiditySettings>       ("efektaHumiditySettings");
+    Registry <ActionObject>::add <ActionsEfekta::CO2Settings>            ("efektaCO2Settings");
+    Registry <ActionObject>::add <ActionsEfekta::PMSensor>               ("efektaPMSensor");
+    Registry <ActionObject>::add <ActionsEfekta::VOCSensor>              ("efektaVOCSensor");
+
+    Registry <ActionObject>::add <ActionsPTVO::ChangePattern>            ("ptvoChangePattern");
+    Registry <ActionObject>::add <ActionsPTVO::Count>                    ("ptvoCount");
+    Registry <ActionObject>::add <ActionsPTVO::Pattern>                  ("ptvoPattern");
+    Registry <ActionObject>::add <ActionsPTVO::SerialData>               ("ptvoSerialData");
 }
 
 Property ActionObject::endpointProperty(const QString &name)
@@ -11,6 +11,9 @@
 #define IKEA_GROUP                      0x0385
 #define GREEN_POWER_GROUP               0x0B84
 
+#define STATUS_NWK_NO_ROUTE             0xCD
+#define STATUS_MAC_NO_ACK               0xE9
+
 #define PROFILE_IPM                     0x0101 // Industrial Plant Monitoring
 #define PROFILE_HA                      0x0104 // Home Automation
 #define PROFILE_CBA                     0x0105 // Commercial Building Automation
@@ -253,6 +256,7 @@ signals:
     void zdoMessageReveived(quint16 networkAddress, quint16 clusterId, const QByteArray &payload);
     void zclMessageReveived(quint16 networkAddress, quint8 endpointId, quint16 clusterId, quint8 linkQuality, const QByteArray &data);
     void rawMessageReveived(const QByteArray &ieeeAddress, quint16 clusterId, quint8 linkQuality, const QByteArray &data);
+    void routeReceived(quint16 networkAddress, const QList <quint16> &relays);
 
 };
 
@@ -2,29 +2,29 @@
 
 void BindingObject::registerMetaTypes(void)
 {
-    qRegisterMetaType <Bindings::Battery>               ("batteryBinding");
-    qRegisterMetaType <Bindings::DeviceTemperature>     ("deviceTemperatureBinding");
-    qRegisterMetaType <Bindings::Scene>                 ("sceneBinding");
-    qRegisterMetaType <Bindings::Status>                ("statusBinding");
-    qRegisterMetaType <Bindings::Level>                 ("levelBinding");
-    qRegisterMetaType <Bindings::Time>                  ("timeBinding");
-    qRegisterMetaType <Bindings::AnalogInput>           ("analogInputBinding");
-    qRegisterMetaType <Bindings::AnalogOutput>          ("analogOutputBinding");
-    qRegisterMetaType <Bindings::MultistateInput>       ("multistateInputBinding");
-    qRegisterMetaType <Bindings::PollControl>           ("pollControlBinding");
-    qRegisterMetaType <Bindings::Cover>                 ("coverBinding");
-    qRegisterMetaType <Bindings::Thermostat>            ("thermostatBinding");
-    qRegisterMetaType <Bindings::Fan>                   ("fanBinding");
-    qRegisterMetaType <Bindings::Color>                 ("colorBinding");
-    qRegisterMetaType <Bindings::Illuminance>           ("illuminanceBinding");
-    qRegisterMetaType <Bindings::Temperature>           ("temperatureBinding");
-    qRegisterMetaType <Bindings::Pressure>              ("pressureBinding");
-    qRegisterMetaType <Bindings::Humidity>              ("humidityBinding");
-    qRegisterMetaType <Bindings::Occupancy>             ("occupancyBinding");
-    qRegisterMetaType <Bindings::Moisture>              ("moistureBinding");
-    qRegisterMetaType <Bindings::CO2>                   ("co2Binding");
-    qRegisterMetaType <Bindings::PM25>                  ("pm25Binding");
-    qRegisterMetaType <Bindings::Energy>                ("energyBinding");
-    qRegisterMetaType <Bindings::Power>                 ("powerBinding");
-    qRegisterMetaType <Bindings::Perenio>               ("perenioBinding");
+    Registry <BindingObject>::add <Bindings::Battery>           ("battery");
+    Registry <BindingObject>::add <Bindings::DeviceTemperature> ("deviceTemperature");
+    Registry <BindingObject>::add <Bindings::Scene>             ("scene");
+    Registry <BindingObject>::add <Bindings::Status>            ("status");
+    Registry <BindingObject>::add <Bindings::Level>             ("level");
+    Registry <BindingObject>::add <Bindings::Time>              ("time");
+    Registry <BindingObject>::add <Bindings::AnalogInput>       ("analogInput");
+    Registry <BindingObject>::add <Bindings::AnalogOutput>      ("analogOutput");
+    Registry <BindingObject>::add <Bindings::MultistateInput>   ("multistateInput");
+    Registry <BindingObject>::add <Bindings::PollControl>       ("pollControl");
+    Registry <BindingObject>::add <Bindings::Cover>             ("cover");
+    Registry <BindingObject>::add <Bindings::Thermostat>        ("thermostat");
+    Registry <BindingObject>::add <Bindings::Fan>               ("fan");
+    Registry <BindingObject>::add <Bindings::Color>             ("color");
+    Registry <BindingObject>::add <Bindings::Illuminance>       ("illuminance");
+    Registry <BindingObject>::add <Bindings::Temperature>       ("temperature");
+    Registry <BindingObject>::add <Bindings::Pressure>          ("pressure");
+    Registry <BindingObject>::add <Bindings::Humidity>          ("humidity");
+    Registry <BindingObject>::add <Bindings::Occupancy>         ("occupancy");
+    Registry <BindingObject>::add <Bindings::Moisture>          ("moisture");
+    Registry <BindingObject>::add <Bindings::CO2>               ("co2");
+    Registry <BindingObject>::add <Bindings::PM25>              ("pm25");
+    Registry <BindingObject>::add <Bindings::Energy>            ("energy");
+    Registry <BindingObject>::add <Bindings::Power>             ("power");
+    Registry <BindingObject>::add <Bindings::Perenio>           ("perenio");
 }
@@ -2,6 +2,7 @@
 #define BINDING_H
 
 #include <QSharedPointer>
+#include "registry.h"
 #include "zcl.h"
 
 class BindingObject;
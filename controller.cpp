@@ -1,7 +1,7 @@
 #include "controller.h"
 #include "logger.h"
 
-Controller::Controller(const QString &configFile) : HOMEd(configFile), m_avaliabilityTimer(new QTimer(this)), m_propertiesTimer(new QTimer(this)), m_zigbee(new ZigBee(getConfig(), this)), m_commands(QMetaEnum::fromType <Command> ()), m_networkStarted(false)
+Controller::Controller(const QString &configFile) : HOMEd(configFile), m_avaliabilityTimer(new QTimer(this)), m_lastSeenTimer(new QTimer(this)), m_propertiesTimer(new QTimer(this)), m_republishTimer(new QTimer(this)), m_publishTimer(new QTimer(this)), m_zigbee(new ZigBee(getConfig(), this)), m_client(findChild <QMqttClient*> ()), m_commands(QMetaEnum::fromType <Command> ()), m_networkStarted(false), m_sessionRestored(false), m_republishCredit(0)
 {
     logInfo << "Starting version" << SERVICE_VERSION;
     logInfo << "Configuration file is" << getConfig()->fileName();
@@ -10,35 +10,379 @@ Controller::Controller(const QString &configFile) : HOMEd(configFile), m_avaliab
     m_haStatus = getConfig()->value("homeassistant/status", "homeassistant/status").toString();
     m_haEnabled = getConfig()->value("homeassistant/enabled", false).toBool();
 
+    m_delta = getConfig()->value("mqtt/delta", false).toBool();
+    m_snapshotInterval = getConfig()->value("mqtt/snapshot", 300).toInt();
+    m_republishRate = getConfig()->value("mqtt/rate", 0).toDouble();
+    m_cbor = getConfig()->value("mqtt/cbor", false).toBool();
+
+    if (m_client)
+        connect(m_client, &QMqttClient::brokerSessionRestored, this, &Controller::sessionRestored);
+    else
+    {
+        logWarning << "MQTT client not found, payloads fall back to mqttPublish and CBOR mirror is disabled";
+        m_cbor = false;
+    }
+
     connect(m_avaliabilityTimer, &QTimer::timeout, this, &Controller::updateAvailability);
+    connect(m_lastSeenTimer, &QTimer::timeout, this, &Controller::updateLastSeen);
     connect(m_propertiesTimer, &QTimer::timeout, this, &Controller::updateProperties);
+    connect(m_republishTimer, &QTimer::timeout, this, &Controller::handleRepublish);
+    connect(m_publishTimer, &QTimer::timeout, this, &Controller::handlePublish);
 
     connect(m_zigbee, &ZigBee::networkStarted, this, &Controller::networkStarted);
     connect(m_zigbee, &ZigBee::deviceEvent, this, &Controller::deviceEvent);
     connect(m_zigbee, &ZigBee::endpointUpdated, this, &Controller::endpointUpdated);
+    connect(m_zigbee, &ZigBee::deviceSeen, this, &Controller::deviceSeen);
     connect(m_zigbee, &ZigBee::statusUpdated, this, &Controller::statusUpdated);
 
-    m_avaliabilityTimer->start(UPDATE_AVAILABILITY_INTERVAL);
+    m_avaliabilityTimer->setSingleShot(true);
+    m_lastSeenTimer->setSingleShot(true);
     m_propertiesTimer->setSingleShot(true);
+    m_publishTimer->setSingleShot(true);
 
     m_zigbee->devices()->setNames(getConfig()->value("mqtt/names", false).toBool());
     m_zigbee->init();
 }
 
-void Controller::publishExposes(DeviceObject *device, bool remove)
+QString Controller::deviceTopic(DeviceObject *device)
+{
+    return m_zigbee->devices()->names() ? device->name() : device->ieeeAddress().toHex(':');
+}
+
+QMap <QString, exposeStateStruct> Controller::exposesState(DeviceObject *device)
+{
+    QJsonObject json = {{"name", device->name()}, {"active", device->active()}, {"discovery", device->discovery()}, {"manufacturerName", device->manufacturerName()}, {"modelName", device->modelName()}, {"firmware", device->firmware()}, {"version", device->version()}, {"description", device->description()}, {"names", m_zigbee->devices()->names()}, {"options", QJsonObject::fromVariantMap(device->options())}}, endpoints;
+    QByteArray data = QJsonDocument(json).toJson(QJsonDocument::Compact);
+    QMap <QString, exposeStateStruct> map;
+
+    for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+    {
+        QJsonArray exposes;
+
+        for (int i = 0; i < it.value()->exposes().count(); i++)
+        {
+            const Expose &expose = it.value()->exposes().at(i);
+            QString key = QString("%1/%2").arg(it.key()).arg(expose->name());
+
+            exposes.append(expose->name());
+
+            if (!m_haEnabled)
+                continue;
+
+            map.insert(key, {QCryptographicHash::hash(QByteArray(data).append(key.toUtf8()), QCryptographicHash::Md5), it.key(), expose});
+        }
+
+        endpoints.insert(QString::number(it.key()), exposes);
+    }
+
+    json.insert("endpoints", endpoints);
+    map.insert(QString(), {QCryptographicHash::hash(QJsonDocument(json).toJson(QJsonDocument::Compact), QCryptographicHash::Md5), 0, Expose()});
+    return map;
+}
+
+void Controller::publishExposeList(DeviceObject *device, const QMap <quint8, QList <Expose>> &exposes, bool remove)
 {
+    QMap <quint8, QList <Expose>> backup;
+
+    for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+    {
+        backup.insert(it.key(), it.value()->exposes());
+        it.value()->exposes() = exposes.value(it.key());
+    }
+
     device->publishExposes(this, device->ieeeAddress().toHex(':'), device->ieeeAddress().toHex(), m_haPrefix, m_haEnabled, m_zigbee->devices()->names(), remove);
 
+    for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+        it.value()->exposes() = backup.value(it.key());
+}
+
+bool Controller::publishExposes(DeviceObject *device, bool remove)
+{
+    QMap <QString, exposeStateStruct> state = exposesState(device), &cache = m_exposes[device->ieeeAddress()];
+    QMap <quint8, QList <Expose>> added, removed;
+
+    for (auto it = cache.begin(); it != cache.end(); it++)
+        if (!it.value().expose.isNull() && !state.contains(it.key()))
+            removed[it.value().endpointId].append(it.value().expose);
+
+    if (!removed.isEmpty())
+        publishExposeList(device, removed, true);
+
     if (remove)
-        return;
+    {
+        device->publishExposes(this, device->ieeeAddress().toHex(':'), device->ieeeAddress().toHex(), m_haPrefix, m_haEnabled, m_zigbee->devices()->names(), true);
+        m_exposes.remove(device->ieeeAddress());
+        return true;
+    }
 
     m_propertiesTimer->start(UPDATE_PROPERTIES_DELAY);
+
+    for (auto it = state.begin(); it != state.end(); it++)
+    {
+        auto item = cache.find(it.key());
+
+        if (it.value().expose.isNull() || (item != cache.end() && item.value().hash == it.value().hash))
+            continue;
+
+        added[it.value().endpointId].append(it.value().expose);
+    }
+
+    if (!added.isEmpty())
+        publishExposeList(device, added, false);
+
+    if (removed.isEmpty() && added.isEmpty() && cache.value(QString()).hash == state.value(QString()).hash)
+        return false;
+
+    device->publishExposes(this, device->ieeeAddress().toHex(':'), device->ieeeAddress().toHex(), m_haPrefix, false, m_zigbee->devices()->names(), false);
+    cache = state;
+    return true;
+}
+
+void Controller::publishProperties(DeviceObject *device, quint8 endpointId, bool snapshot)
+{
+    QMap <QString, QVariant> endpointMap, deviceMap = {{"linkQuality", device->linkQuality()}};
+    bool retain = device->options().value("retain").toBool();
+
+    for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+    {
+        for (int i = 0; i < it.value()->properties().count(); i++)
+        {
+            const Property &property = it.value()->properties().at(i);
+            QMap <QString, QVariant> &map = property->multiple() ? endpointMap : deviceMap;
+
+            if (!property->value().isValid() || (property->multiple() && it.value()->id() != endpointId))
+                continue;
+
+            if (property->value().type() != QVariant::Map)
+                map.insert(property->name(), property->value());
+            else
+                map.insert(property->value().toMap());
+
+            if (property->name() == "action" || property->name() == "scene")
+                property->clearValue();
+        }
+
+        it.value()->setUpdated(false);
+    }
+
+    if (!endpointMap.isEmpty())
+        publishDelta(mqttTopic("fd/zigbee/%1/%2").arg(deviceTopic(device)).arg(endpointId), endpointMap, retain, snapshot);
+
+    publishDelta(mqttTopic("fd/zigbee/%1").arg(deviceTopic(device)), deviceMap, retain, snapshot);
+}
+
+void Controller::publishPayload(const QString &topic, const QMap <QString, QVariant> &map, bool retain)
+{
+    if (m_client)
+        m_client->publish(topic, map.isEmpty() && retain ? QByteArray() : m_writer.write(map), 0, retain);
+    else
+        mqttPublish(topic, QJsonObject::fromVariantMap(map), retain);
+
+    if (!m_cbor)
+        return;
+
+    m_client->publish(QString(topic).replace(0, mqttTopic().length(), mqttTopic("cbor/")), map.isEmpty() && retain ? QByteArray() : QCborValue(QCborMap::fromVariantMap(map)).toCbor(), 0, retain);
+}
+
+void Controller::publishDelta(const QString &topic, const QMap <QString, QVariant> &map, bool retain, bool snapshot)
+{
+    qint64 time = QDateTime::currentSecsSinceEpoch();
+    auto it = m_published.find(topic);
+
+    if (!m_delta)
+    {
+        publishPayload(topic, map, retain);
+        return;
+    }
+
+    if (snapshot || it == m_published.end() || time - m_snapshots.value(topic) >= m_snapshotInterval)
+    {
+        publishPayload(topic, map, retain);
+        m_snapshots.insert(topic, time);
+        it = m_published.insert(topic, map);
+    }
+    else
+    {
+        QMap <QString, QVariant> delta;
+
+        for (auto item = map.begin(); item != map.end(); item++)
+        {
+            auto value = it.value().constFind(item.key());
+
+            if (value != it.value().constEnd() && value.value() == item.value())
+                continue;
+
+            delta.insert(item.key(), item.value());
+            it.value().insert(item.key(), item.value());
+        }
+
+        if (delta.isEmpty())
+            return;
+
+        publishPayload(topic, delta);
+    }
+
+    it.value().remove("action");
+    it.value().remove("scene");
+}
+
+void Controller::resetPublished(DeviceObject *device)
+{
+    QString topic = mqttTopic("fd/zigbee/%1").arg(deviceTopic(device));
+
+    for (auto it = m_published.begin(); it != m_published.end(); )
+    {
+        if (it.key() != topic && !it.key().startsWith(QString(topic).append('/')))
+        {
+            it++;
+            continue;
+        }
+
+        m_snapshots.remove(it.key());
+        it = m_published.erase(it);
+    }
+
+    for (auto it = m_publishStates.begin(); it != m_publishStates.end(); )
+    {
+        if (it.key().first != device->ieeeAddress())
+        {
+            it++;
+            continue;
+        }
+
+        m_publishDeadlines.remove(it.key());
+        it = m_publishStates.erase(it);
+    }
+}
+
+void Controller::publishEndpoint(DeviceObject *device, quint8 endpointId, bool track)
+{
+    QPair <QByteArray, quint8> key = {device->ieeeAddress(), endpointId};
+    bool snapshot = m_propertiesPending.remove(key);
+
+    m_publishDeadlines.remove(key);
+
+    if (track)
+    {
+        publishStateStruct &state = m_publishStates[key];
+
+        state.lastPublish = QDateTime::currentMSecsSinceEpoch();
+        state.values.clear();
+
+        for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+        {
+            for (int i = 0; i < it.value()->properties().count(); i++)
+            {
+                const Property &property = it.value()->properties().at(i);
+
+                if (!property->value().isValid() || (property->multiple() && it.value()->id() != endpointId))
+                    continue;
+
+                state.values.insert(property->name(), property->value());
+            }
+        }
+    }
+
+    publishProperties(device, endpointId, snapshot);
+}
+
+void Controller::schedulePublish(void)
+{
+    qint64 deadline = 0;
+
+    for (auto it = m_publishDeadlines.begin(); it != m_publishDeadlines.end(); it++)
+        if (!deadline || it.value() < deadline)
+            deadline = it.value();
+
+    if (!deadline)
+    {
+        m_publishTimer->stop();
+        return;
+    }
+
+    m_publishTimer->start(static_cast <int> (qMax <qint64> (0, deadline - QDateTime::currentMSecsSinceEpoch())));
+}
+
+void Controller::publishAvailability(DeviceObject *device)
+{
+    publishPayload(mqttTopic("device/zigbee/%1").arg(deviceTopic(device)), {{"lastSeen", device->lastSeen()}, {"status", device->availability() == Availability::Online ? "online" : "offline"}}, true);
+    m_lastSeen.insert(device->ieeeAddress(), device->lastSeen());
+    m_seen.remove(device->ieeeAddress());
+}
+
+void Controller::checkAvailability(DeviceObject *device)
+{
+    Availability check = device->availability();
+    qint64 time = QDateTime::currentSecsSinceEpoch(), timeout = device->options().value("availability").toInt();
+
+    removeDeadline(device->ieeeAddress());
+
+    if (device->removed() || device->logicalType() == LogicalType::Coordinator)
+        return;
+
+    if (!timeout)
+        timeout = device->batteryPowered() ? 86400 : 600;
+
+    device->setAvailability(device->active() ? time - device->lastSeen() <= timeout ? Availability::Online : Availability::Offline : Availability::Inactive);
+
+    if (device->availability() == Availability::Online)
+    {
+        qint64 deadline = device->lastSeen() + timeout + 1;
+        m_deadlines.insert(deadline, device->ieeeAddress());
+        m_expiry.insert(device->ieeeAddress(), deadline);
+    }
+
+    if (device->availability() != check)
+        publishAvailability(device);
+    else if (m_lastSeen.value(device->ieeeAddress()) != device->lastSeen())
+        m_seen.insert(device->ieeeAddress());
+
+    if (!m_seen.isEmpty() && !m_lastSeenTimer->isActive())
+        m_lastSeenTimer->start(UPDATE_LAST_SEEN_DELAY);
+}
+
+void Controller::removeDeadline(const QByteArray &ieeeAddress)
+{
+    auto it = m_expiry.find(ieeeAddress);
+
+    if (it == m_expiry.end())
+        return;
+
+    m_deadlines.remove(it.value(), ieeeAddress);
+    m_expiry.erase(it);
+}
+
+void Controller::scheduleAvailability(void)
+{
+    if (m_deadlines.isEmpty())
+    {
+        m_avaliabilityTimer->stop();
+        return;
+    }
+
+    m_avaliabilityTimer->start(static_cast <int> (qBound <qint64> (0, (m_deadlines.firstKey() - QDateTime::currentSecsSinceEpoch()) * 1000, 86400000)));
 }
 
 void Controller::serviceOnline(void)
 {
     for (auto it = m_zigbee->devices()->begin(); it != m_zigbee->devices()->end(); it++)
+    {
+        if (m_republishRate)
+        {
+            if (m_exposesPending.contains(it.key()))
+                continue;
+
+            m_exposesPending.insert(it.key());
+            m_exposesQueue.append(it.key());
+
+            continue;
+        }
+
         publishExposes(it.value().data());
+    }
+
+    if (!m_exposesQueue.isEmpty() && !m_republishTimer->isActive())
+        m_republishTimer->start(REPUBLISH_INTERVAL);
 
     if (m_haEnabled)
         mqttPublishDiscovery("ZigBee", SERVICE_VERSION, m_haPrefix, true);
@@ -55,6 +399,11 @@ void Controller::quit(void)
 
 void Controller::mqttConnected(void)
 {
+    if (!m_sessionRestored)
+        m_exposes.clear();
+
+    m_sessionRestored = false;
+
     mqttSubscribe(mqttTopic("command/zigbee"));
     mqttSubscribe(mqttTopic("td/zigbee/#"));
 
@@ -127,8 +476,15 @@ void Controller::mqttReceived(const QByteArray &message, const QMqttTopicName &t
                 break;
 
             case  Command::getProperties:
+            {
+                Device device = m_zigbee->devices()->byName(json.value("device").toString());
+
+                if (!device.isNull())
+                    resetPublished(device.data());
+
                 m_zigbee->getProperties(json.value("device").toString());
                 break;
+            }
 
             case Command::clusterRequest:
             case Command::globalRequest:
@@ -142,8 +498,20 @@ void Controller::mqttReceived(const QByteArray &message, const QMqttTopicName &t
             case Command::touchLinkReset:
                 m_zigbee->touchLinkRequest(QByteArray::fromHex(json.value("ieeeAddress").toString().toUtf8()), static_cast <quint8> (json.value("channel").toInt()), true);
                 break;
+
+            case Command::exportDatabase:
+                m_zigbee->devices()->exportDatabase();
+                break;
+
+            case Command::getNetworkMap:
+                mqttPublish(mqttTopic("map/zigbee"), m_zigbee->topology()->serialize());
+                break;
         }
     }
+    else if (subTopic == "td/zigbee")
+    {
+        m_zigbee->deviceActions(QJsonDocument::fromJson(message).array().toVariantList());
+    }
     else if (subTopic.startsWith("td/zigbee/"))
     {
         QList <QString> list = subTopic.split('/');
@@ -178,33 +546,54 @@ void Controller::mqttReceived(const QByteArray &message, const QMqttTopicName &t
     }
 }
 
+void Controller::sessionRestored(void)
+{
+    m_sessionRestored = true;
+}
+
 void Controller::updateAvailability(void)
 {
     qint64 time = QDateTime::currentSecsSinceEpoch();
 
-    for (auto it = m_zigbee->devices()->begin(); it != m_zigbee->devices()->end(); it++)
+    while (!m_deadlines.isEmpty() && m_deadlines.firstKey() <= time)
     {
-        Availability check = it.value()->availability();
-        qint64 timeout = it.value()->options().value("availability").toInt();
+        Device device = m_zigbee->devices()->value(m_deadlines.first());
 
-        if (it.value()->removed() || it.value()->logicalType() == LogicalType::Coordinator)
+        m_expiry.remove(m_deadlines.first());
+        m_deadlines.erase(m_deadlines.begin());
+
+        if (device.isNull())
             continue;
 
-        if (!timeout)
-            timeout = it.value()->batteryPowered() ? 86400 : 600;
+        checkAvailability(device.data());
+    }
+
+    scheduleAvailability();
+}
+
+void Controller::updateLastSeen(void)
+{
+    QSet <QByteArray> list = m_seen;
 
-        it.value()->setAvailability(it.value()->active() ? time - it.value()->lastSeen() <= timeout ? Availability::Online : Availability::Offline : Availability::Inactive);
+    for (auto it = list.begin(); it != list.end(); it++)
+    {
+        Device device = m_zigbee->devices()->value(*it);
 
-        if (it.value()->availability() == check && m_lastSeen.value(it.value()->ieeeAddress()) == it.value()->lastSeen())
+        if (device.isNull() || device->removed())
+        {
+            m_seen.remove(*it);
             continue;
+        }
 
-        mqttPublish(mqttTopic("device/zigbee/%1").arg(m_zigbee->devices()->names() ? it.value()->name() : it.value()->ieeeAddress().toHex(':')), {{"lastSeen", it.value()->lastSeen()}, {"status", it.value()->availability() == Availability::Online ? "online" : "offline"}}, true);
-        m_lastSeen.insert(it.value()->ieeeAddress(), it.value()->lastSeen());
+        publishAvailability(device.data());
     }
 }
 
 void Controller::updateProperties(void)
 {
+    m_propertiesQueue.clear();
+    m_propertiesPending.clear();
+
     for (auto it = m_zigbee->devices()->begin(); it != m_zigbee->devices()->end(); it++)
     {
         const Device &device = it.value();
@@ -214,14 +603,99 @@ void Controller::updateProperties(void)
             if (it.value()->properties().isEmpty())
                 continue;
 
-            endpointUpdated(device.data(), it.key());
+            if (m_republishRate)
+            {
+                QPair <QByteArray, quint8> key = {device->ieeeAddress(), it.key()};
+                m_propertiesPending.insert(key);
+                m_propertiesQueue.append(key);
+                continue;
+            }
+
+            publishProperties(device.data(), it.key(), true);
         }
     }
+
+    if (!m_propertiesQueue.isEmpty() && !m_republishTimer->isActive())
+        m_republishTimer->start(REPUBLISH_INTERVAL);
+}
+
+void Controller::handleRepublish(void)
+{
+    m_republishCredit = qMin(m_republishCredit + m_republishRate * REPUBLISH_INTERVAL / 1000, qMax(m_republishRate, 1.0));
+
+    while (m_republishCredit >= 1 && (!m_exposesQueue.isEmpty() || !m_propertiesQueue.isEmpty()))
+    {
+        if (!m_exposesQueue.isEmpty())
+        {
+            QByteArray ieeeAddress = m_exposesQueue.takeFirst();
+            Device device = m_zigbee->devices()->value(ieeeAddress);
+
+            m_exposesPending.remove(ieeeAddress);
+
+            if (device.isNull() || !publishExposes(device.data()))
+                continue;
+
+            m_republishCredit--;
+
+            if (!m_haEnabled)
+                continue;
+
+            for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+                m_republishCredit -= it.value()->exposes().count();
+
+            continue;
+        }
+
+        QPair <QByteArray, quint8> item = m_propertiesQueue.takeFirst();
+        Device device = m_zigbee->devices()->value(item.first);
+
+        if (!m_propertiesPending.remove(item) || device.isNull() || device->removed())
+            continue;
+
+        m_republishCredit--;
+        publishProperties(device.data(), item.second, true);
+    }
+
+    if (!m_exposesQueue.isEmpty() || !m_propertiesQueue.isEmpty())
+        return;
+
+    m_republishTimer->stop();
+    m_republishCredit = 0;
+}
+
+void Controller::handlePublish(void)
+{
+    qint64 time = QDateTime::currentMSecsSinceEpoch();
+    QList <QPair <QByteArray, quint8>> list;
+
+    for (auto it = m_publishDeadlines.begin(); it != m_publishDeadlines.end(); it++)
+        if (it.value() <= time)
+            list.append(it.key());
+
+    for (int i = 0; i < list.count(); i++)
+    {
+        Device device = m_zigbee->devices()->value(list.at(i).first);
+
+        if (device.isNull() || device->removed())
+        {
+            m_publishDeadlines.remove(list.at(i));
+            continue;
+        }
+
+        publishEndpoint(device.data(), list.at(i).second, true);
+    }
+
+    schedulePublish();
 }
 
 void Controller::networkStarted(void)
 {
     m_networkStarted = true;
+
+    for (auto it = m_zigbee->devices()->begin(); it != m_zigbee->devices()->end(); it++)
+        checkAvailability(it.value().data());
+
+    scheduleAvailability();
     serviceOnline();
 }
 
@@ -237,12 +711,17 @@ void Controller::deviceEvent(DeviceObject *device, ZigBee::Event event, const QJ
         case ZigBee::Event::deviceLeft:
         case ZigBee::Event::deviceRemoved:
         case ZigBee::Event::deviceAboutToRename:
-            mqttPublish(mqttTopic("device/zigbee/%1").arg(m_zigbee->devices()->names() ? device->name() : device->ieeeAddress().toHex(':')), QJsonObject(), true);
+            publishPayload(mqttTopic("device/zigbee/%1").arg(deviceTopic(device)), QMap <QString, QVariant> (), true);
+            resetPublished(device);
+            removeDeadline(device->ieeeAddress());
+            scheduleAvailability();
             remove = true;
             break;
 
         case ZigBee::Event::deviceUpdated:
-            mqttPublish(mqttTopic("device/zigbee/%1").arg(m_zigbee->devices()->names() ? device->name() : device->ieeeAddress().toHex(':')), {{"lastSeen", device->lastSeen()}, {"status", device->availability() == Availability::Online ? "online" : "offline"}}, true);
+            checkAvailability(device);
+            scheduleAvailability();
+            publishAvailability(device);
             break;
 
         default:
@@ -261,35 +740,85 @@ void Controller::deviceEvent(DeviceObject *device, ZigBee::Event event, const QJ
 
 void Controller::endpointUpdated(DeviceObject *device, quint8 endpointId)
 {
-    QMap <QString, QVariant> endpointMap, deviceMap = {{"linkQuality", device->linkQuality()}};
-    bool retain = device->options().value("retain").toBool();
+    QPair <QByteArray, quint8> key = {device->ieeeAddress(), endpointId};
+    qint64 time = QDateTime::currentMSecsSinceEpoch(), interval = -1, debounce = -1, latency = -1, deadline;
+    auto it = m_publishStates.find(key);
 
-    for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+    if (device->publishPolicies().isEmpty() && device->publishPolicy().interval <= 0 && device->publishPolicy().debounce <= 0)
     {
-        for (int i = 0; i < it.value()->properties().count(); i++)
+        publishEndpoint(device, endpointId, it != m_publishStates.end());
+        return;
+    }
+
+    for (auto endpoint = device->endpoints().begin(); endpoint != device->endpoints().end(); endpoint++)
+    {
+        for (int i = 0; i < endpoint.value()->properties().count(); i++)
         {
-            const Property &property = it.value()->properties().at(i);
-            QMap <QString, QVariant> &map = property->multiple() ? endpointMap : deviceMap;
+            const Property &property = endpoint.value()->properties().at(i);
+            publishPolicyStruct policy;
 
-            if (!property->value().isValid() || (property->multiple() && it.value()->id() != endpointId))
+            if (!property->value().isValid() || (property->multiple() && endpoint.value()->id() != endpointId))
                 continue;
 
-            if (property->value().type() != QVariant::Map)
-                map.insert(property->name(), property->value());
-            else
-                map.insert(property->value().toMap());
-
             if (property->name() == "action" || property->name() == "scene")
-                property->clearValue();
+            {
+                publishEndpoint(device, endpointId, it != m_publishStates.end());
+                schedulePublish();
+                return;
+            }
+
+            if (it != m_publishStates.end() && it.value().values.value(property->name()) == property->value())
+                continue;
+
+            policy = device->publishPolicies().value(property->name(), device->publishPolicy());
+            interval = interval < 0 ? policy.interval : qMin(interval, policy.interval);
+            debounce = debounce < 0 ? policy.debounce : qMin(debounce, policy.debounce);
+            latency = latency < 0 ? policy.latency : qMin(latency, policy.latency);
         }
+    }
 
-        it.value()->setUpdated(false);
+    if (interval < 0)
+    {
+        interval = device->publishPolicy().interval;
+        debounce = device->publishPolicy().debounce;
+        latency = device->publishPolicy().latency;
     }
 
-    if (!endpointMap.isEmpty())
-        mqttPublish(mqttTopic("fd/zigbee/%1/%2").arg(m_zigbee->devices()->names() ? device->name() : device->ieeeAddress().toHex(':')).arg(endpointId), QJsonObject::fromVariantMap(endpointMap), retain);
+    if (interval <= 0 && debounce <= 0)
+    {
+        publishEndpoint(device, endpointId, it != m_publishStates.end());
+        return;
+    }
+
+    if (it == m_publishStates.end())
+        it = m_publishStates.insert(key, {0, 0, QMap <QString, QVariant> ()});
+
+    if (!m_publishDeadlines.contains(key))
+        it.value().firstUpdate = time;
+
+    deadline = qMax(it.value().lastPublish + interval, time + debounce);
+
+    if (latency > 0)
+        deadline = qMin(deadline, it.value().firstUpdate + latency);
+
+    if (deadline <= time)
+    {
+        publishEndpoint(device, endpointId, true);
+        schedulePublish();
+        return;
+    }
+
+    m_publishDeadlines.insert(key, deadline);
+    schedulePublish();
+}
+
+void Controller::deviceSeen(DeviceObject *device)
+{
+    if (!m_networkStarted)
+        return;
 
-    mqttPublish(mqttTopic("fd/zigbee/%1").arg(m_zigbee->devices()->names() ? device->name() : device->ieeeAddress().toHex(':')), QJsonObject::fromVariantMap(deviceMap), retain);
+    checkAvailability(device);
+    scheduleAvailability();
 }
 
 void Controller::statusUpdated(const QJsonObject &json)
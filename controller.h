@@ -2,12 +2,31 @@
 #define CONTROLLER_H
 
 #define SERVICE_VERSION                 "3.7.2"
-#define UPDATE_AVAILABILITY_INTERVAL    5000
+#define UPDATE_LAST_SEEN_DELAY          5000
 #define UPDATE_PROPERTIES_DELAY         1000
+#define REPUBLISH_INTERVAL              100
 
+#include <QCryptographicHash>
+#include <QMqttClient>
+#include <QSet>
 #include "homed.h"
+#include "writer.h"
 #include "zigbee.h"
 
+struct exposeStateStruct
+{
+    QByteArray hash;
+    quint8 endpointId;
+    Expose expose;
+};
+
+struct publishStateStruct
+{
+    qint64 lastPublish;
+    qint64 firstUpdate;
+    QMap <QString, QVariant> values;
+};
+
 class Controller : public HOMEd
 {
     Q_OBJECT
@@ -35,23 +54,61 @@ public:
         clusterRequest,
         globalRequest,
         touchLinkScan,
-        touchLinkReset
+        touchLinkReset,
+        exportDatabase,
+        getNetworkMap
     };
 
     Q_ENUM(Command)
 
 private:
 
-    QTimer *m_avaliabilityTimer, *m_propertiesTimer;
+    QTimer *m_avaliabilityTimer, *m_lastSeenTimer, *m_propertiesTimer, *m_republishTimer, *m_publishTimer;
     ZigBee *m_zigbee;
+    QMqttClient *m_client;
+    JsonWriter m_writer;
 
     QMetaEnum m_commands;
     QString m_haPrefix, m_haStatus;
-    bool m_haEnabled, m_networkStarted;
+    bool m_haEnabled, m_networkStarted, m_sessionRestored, m_delta, m_cbor;
+    qint64 m_snapshotInterval;
+    double m_republishRate, m_republishCredit;
+
+    QMultiMap <qint64, QByteArray> m_deadlines;
+    QMap <QByteArray, qint64> m_lastSeen, m_expiry;
+    QSet <QByteArray> m_seen;
+
+    QMap <QString, QMap <QString, QVariant>> m_published;
+    QMap <QString, qint64> m_snapshots;
+    QMap <QByteArray, QMap <QString, exposeStateStruct>> m_exposes;
+
+    QList <QByteArray> m_exposesQueue;
+    QList <QPair <QByteArray, quint8>> m_propertiesQueue;
+    QSet <QByteArray> m_exposesPending;
+    QSet <QPair <QByteArray, quint8>> m_propertiesPending;
+
+    QMap <QPair <QByteArray, quint8>, publishStateStruct> m_publishStates;
+    QMap <QPair <QByteArray, quint8>, qint64> m_publishDeadlines;
+
+    QString deviceTopic(DeviceObject *device);
+
+    QMap <QString, exposeStateStruct> exposesState(DeviceObject *device);
+
+    void publishExposeList(DeviceObject *device, const QMap <quint8, QList <Expose>> &exposes, bool remove);
+    bool publishExposes(DeviceObject *device, bool remove = false);
+    void publishProperties(DeviceObject *device, quint8 endpointId, bool snapshot = false);
+    void publishPayload(const QString &topic, const QMap <QString, QVariant> &map, bool retain = false);
+    void publishDelta(const QString &topic, const QMap <QString, QVariant> &map, bool retain, bool snapshot);
+    void resetPublished(DeviceObject *device);
+
+    void publishEndpoint(DeviceObject *device, quint8 endpointId, bool track);
+    void schedulePublish(void);
 
-    QMap <QByteArray, qint64> m_lastSeen;
+    void publishAvailability(DeviceObject *device);
+    void checkAvailability(DeviceObject *device);
+    void removeDeadline(const QByteArray &ieeeAddress);
+    void scheduleAvailability(void);
 
-    void publishExposes(DeviceObject *device, bool remove = false);
     void serviceOnline(void);
 
 public slots:
@@ -62,13 +119,18 @@ private slots:
 
     void mqttConnected(void) override;
     void mqttReceived(const QByteArray &message, const QMqttTopicName &topic) override;
+    void sessionRestored(void);
 
     void updateAvailability(void);
+    void updateLastSeen(void);
     void updateProperties(void);
+    void handleRepublish(void);
+    void handlePublish(void);
 
     void networkStarted(void);
     void deviceEvent(DeviceObject *device, ZigBee::Event event, const QJsonObject &json);
     void endpointUpdated(DeviceObject *device, quint8 endpointId);
+    void deviceSeen(DeviceObject *device);
     void statusUpdated(const QJsonObject &json);
 
 };
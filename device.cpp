@@ -7,7 +7,7 @@
 #include "controller.h"
 #include "logger.h"
 
-DeviceList::DeviceList(QSettings *config, QObject *parent) : QObject(parent), m_config(config), m_databaseTimer(new QTimer(this)), m_propertiesTimer(new QTimer(this)), m_names(false), m_permitJoin(false), m_sync(false)
+DeviceList::DeviceList(QSettings *config, QObject *parent) : QObject(parent), m_config(config), m_databaseTimer(new QTimer(this)), m_propertiesTimer(new QTimer(this)), m_names(false), m_permitJoin(false), m_sync(false), m_migrate(false)
 {
     QFile file("/usr/share/homed-common/expose.json");
 
@@ -18,8 +18,10 @@ DeviceList::DeviceList(QSettings *config, QObject *parent) : QObject(parent), m_
     PollObject::registerMetaTypes();
     ExposeObject::registerMetaTypes();
 
-    m_databaseFile.setFileName(m_config->value("device/database", "/opt/homed-zigbee/database.json").toString());
-    m_propertiesFile.setFileName(m_config->value("device/properties", "/opt/homed-zigbee/properties.json").toString());
+    m_cbor = m_config->value("device/format", "json").toString() == "cbor";
+
+    m_databaseFile.setFileName(m_config->value("device/database", m_cbor ? "/opt/homed-zigbee/database.cbor" : "/opt/homed-zigbee/database.json").toString());
+    m_propertiesFile.setFileName(m_config->value("device/properties", m_cbor ? "/opt/homed-zigbee/properties.cbor" : "/opt/homed-zigbee/properties.json").toString());
     m_optionsFile.setFileName(m_config->value("device/options", "/opt/homed-zigbee/options.json").toString());
     m_externalDir.setPath(m_config->value("device/external", "/opt/homed-zigbee/external").toString());
     m_libraryDir.setPath(m_config->value("device/library", "/usr/share/homed-zigbee").toString());
@@ -52,10 +54,9 @@ void DeviceList::init(void)
     QList <QString> list = {"previous", "enabled"};
     QJsonObject json;
 
-    if (!m_databaseFile.open(QFile::ReadOnly))
+    if (!readFile(m_databaseFile, json))
         return;
 
-    json = QJsonDocument::fromJson(m_databaseFile.readAll()).object();
     unserializeDevices(json.value("devices").toArray());
 
     switch (list.indexOf(m_config->value("device/join").toString()))
@@ -65,13 +66,15 @@ void DeviceList::init(void)
         default: m_permitJoin = false; break;
     }
 
-    m_databaseFile.close();
+    if (readFile(m_propertiesFile, json))
+        unserializeProperties(json);
 
-    if (!m_propertiesFile.open(QFile::ReadOnly))
+    if (!m_migrate)
         return;
 
-    unserializeProperties(QJsonDocument::fromJson(m_propertiesFile.readAll()).object());
-    m_propertiesFile.close();
+    logInfo << "Migrating database and properties to" << (m_cbor ? "CBOR" : "JSON") << "format";
+    storeDatabase();
+    storeProperties();
 }
 
 void DeviceList::storeDatabase(void)
@@ -85,6 +88,23 @@ void DeviceList::storeProperties(void)
     m_propertiesTimer->start(STORE_PROPERTIES_DELAY);
 }
 
+void DeviceList::exportDatabase(void)
+{
+    QString databaseFile = jsonFileName(m_databaseFile), propertiesFile = jsonFileName(m_propertiesFile);
+    QFile database(databaseFile), properties(propertiesFile);
+
+    if (!m_cbor)
+    {
+        logWarning << "Database export skipped, storage format is already JSON";
+        return;
+    }
+
+    if (!writeFile(database, QJsonDocument(serializeDatabase()).toJson()) || !writeFile(properties, QJsonDocument(serializeProperties()).toJson()))
+        return;
+
+    logInfo << "Database exported to" << databaseFile << "and" << propertiesFile;
+}
+
 Device DeviceList::byName(const QString &name)
 {
     for (auto it = begin(); it != end(); it++)
@@ -290,6 +310,67 @@ void DeviceList::setupDevice(const Device &device)
         device->setDescription(QString("%1/%2").arg(device->manufacturerName(), device->modelName()));
         recognizeDevice(device);
     }
+
+    device->setPublishPolicy({device->options().value("publishInterval").toLongLong(), device->options().value("publishDebounce").toLongLong(), device->options().value("publishLatency").toLongLong()});
+    device->publishPolicies().clear();
+
+    for (auto it = device->options().begin(); it != device->options().end(); it++)
+    {
+        int index = it.key().indexOf("Publish");
+        QString type = it.key().mid(index + 7);
+        auto policy = device->publishPolicies().end();
+
+        if (index <= 0 || (type != "Interval" && type != "Debounce" && type != "Latency"))
+            continue;
+
+        policy = device->publishPolicies().find(it.key().left(index));
+
+        if (policy == device->publishPolicies().end())
+            policy = device->publishPolicies().insert(it.key().left(index), device->publishPolicy());
+
+        if (type == "Interval")
+            policy.value().interval = it.value().toLongLong();
+        else if (type == "Debounce")
+            policy.value().debounce = it.value().toLongLong();
+        else
+            policy.value().latency = it.value().toLongLong();
+    }
+
+    for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+    {
+        QMap <QString, valueFilterStruct> filters;
+
+        for (auto option = device->options().begin(); option != device->options().end(); option++)
+        {
+            QList <QString> list = option.key().split('_');
+            QString key = list.value(0);
+            int length = key.endsWith("Deadband") ? 8 : key.endsWith("Round") ? 5 : 0;
+            auto filter = filters.end();
+
+            if (!length || (list.count() > 1 && list.value(1).toInt() != it.key()))
+                continue;
+
+            filter = filters.find(key.left(key.length() - length));
+
+            if (filter == filters.end())
+                filter = filters.insert(key.left(key.length() - length), {0, false, -1});
+
+            if (length == 8)
+            {
+                filter.value().deadband = option.value().toString().remove('%').toDouble();
+                filter.value().percent = option.value().toString().endsWith('%');
+            }
+            else
+                filter.value().round = option.value().toInt();
+        }
+
+        for (int i = 0; i < it.value()->properties().count(); i++)
+        {
+            const Property &property = it.value()->properties().at(i);
+            property->setFilters(filters);
+            property->setup();
+        }
+    }
 }
 
 void DeviceList::setupEndpoint(const Endpoint &endpoint, const QJsonObject &json, bool multiple)
@@ -300,11 +381,11 @@ void DeviceList::setupEndpoint(const Endpoint &endpoint, const QJsonObject &json
 
     for (auto it = properties.begin(); it != properties.end(); it++)
     {
-        int type = QMetaType::type(QString(it->toString()).append("Property").toUtf8());
+        PropertyObject *item = Registry <PropertyObject>::create(it->toString());
 
-        if (type)
+        if (item)
         {
-            Property property(reinterpret_cast <PropertyObject*> (QMetaType::create(type)));
+            Property property(item);
             QVariant timeout = device->options().value(QString(property->name()).append("ResetTimeout"));
 
             property->setParent(endpoint.data());
@@ -355,11 +436,11 @@ void DeviceList::setupEndpoint(const Endpoint &endpoint, const QJsonObject &json
 
     for (auto it = actions.begin(); it != actions.end(); it++)
     {
-        int type = QMetaType::type(QString(it->toString()).append("Action").toUtf8());
+        ActionObject *item = Registry <ActionObject>::create(it->toString());
 
-        if (type)
+        if (item)
         {
-            Action action(reinterpret_cast <ActionObject*> (QMetaType::create(type)));
+            Action action(item);
             action->setParent(endpoint.data());
             endpoint->actions().append(action);
             continue;
@@ -390,11 +471,11 @@ void DeviceList::setupEndpoint(const Endpoint &endpoint, const QJsonObject &json
 
     for (auto it = bindings.begin(); it != bindings.end(); it++)
     {
-        int type = QMetaType::type(QString(it->toString()).append("Binding").toUtf8());
+        BindingObject *item = Registry <BindingObject>::create(it->toString());
 
-        if (type)
+        if (item)
         {
-            Binding binding(reinterpret_cast <BindingObject*> (QMetaType::create(type)));
+            Binding binding(item);
             endpoint->bindings().append(binding);
             continue;
         }
@@ -404,11 +485,11 @@ void DeviceList::setupEndpoint(const Endpoint &endpoint, const QJsonObject &json
 
     for (auto it = reportings.begin(); it != reportings.end(); it++)
     {
-        int type = QMetaType::type(QString(it->toString()).append("Reporting").toUtf8());
+        ReportingObject *item = Registry <ReportingObject>::create(it->toString());
 
-        if (type)
+        if (item)
         {
-            Reporting reporting(reinterpret_cast <ReportingObject*> (QMetaType::create(type)));
+            Reporting reporting(item);
             endpoint->reportings().append(reporting);
             continue;
         }
@@ -418,11 +499,11 @@ void DeviceList::setupEndpoint(const Endpoint &endpoint, const QJsonObject &json
 
     for (auto it = polls.begin(); it != polls.end(); it++)
     {
-        int type = QMetaType::type(QString(it->toString()).append("Poll").toUtf8());
+        PollObject *item = Registry <PollObject>::create(it->toString());
 
-        if (type)
+        if (item)
         {
-            Poll poll(reinterpret_cast <PollObject*> (QMetaType::create(type)));
+            Poll poll(item);
             endpoint->polls().append(poll);
             continue;
         }
@@ -962,127 +1043,165 @@ void DeviceList::unserializeProperties(const QJsonObject &properties)
         logInfo << "Properties restored";
 }
 
-QJsonArray DeviceList::serializeDevices(void)
+QJsonObject DeviceList::serializeDevice(const Device &device)
 {
-    QJsonArray array;
+    QJsonObject json = {{"ieeeAddress", QString(device->ieeeAddress().toHex(':'))}, {"networkAddress", device->networkAddress()}};
 
-    for (auto it = begin(); it != end(); it++)
+    if (!device->removed())
     {
-        const Device &device = it.value();
-        QJsonObject json = {{"ieeeAddress", QString(device->ieeeAddress().toHex(':'))}, {"networkAddress", device->networkAddress()}};
+        json.insert("logicalType", static_cast <quint8> (device->logicalType()));
 
-        if (!device->removed())
-        {
-            json.insert("logicalType", static_cast <quint8> (device->logicalType()));
+        if (device->name() != device->ieeeAddress().toHex(':'))
+            json.insert("name", device->name());
 
-            if (device->name() != device->ieeeAddress().toHex(':'))
-                json.insert("name", device->name());
+        if (!device->manufacturerName().isEmpty())
+            json.insert("manufacturerName", device->manufacturerName());
 
-            if (!device->manufacturerName().isEmpty())
-                json.insert("manufacturerName", device->manufacturerName());
+        if (!device->modelName().isEmpty())
+            json.insert("modelName", device->modelName());
 
-            if (!device->modelName().isEmpty())
-                json.insert("modelName", device->modelName());
+        if (!device->firmware().isEmpty())
+            json.insert("firmware", device->firmware());
 
-            if (!device->firmware().isEmpty())
-                json.insert("firmware", device->firmware());
+        if (device->logicalType() != LogicalType::Coordinator)
+        {
+            json.insert("active", device->active());
+            json.insert("discovery", device->discovery());
+            json.insert("cloud", device->cloud());
+            json.insert("supported", device->supported());
+            json.insert("interviewFinished", device->interviewFinished());
+            json.insert("manufacturerCode", device->manufacturerCode());
+            json.insert("powerSource", device->powerSource());
 
-            if (device->logicalType() != LogicalType::Coordinator)
-            {
-                json.insert("active", device->active());
-                json.insert("discovery", device->discovery());
-                json.insert("cloud", device->cloud());
-                json.insert("supported", device->supported());
-                json.insert("interviewFinished", device->interviewFinished());
-                json.insert("manufacturerCode", device->manufacturerCode());
-                json.insert("powerSource", device->powerSource());
+            if (device->version())
+                json.insert("version", device->version());
 
-                if (device->version())
-                    json.insert("version", device->version());
+            if (device->lastSeen())
+                json.insert("lastSeen", device->lastSeen());
 
-                if (device->lastSeen())
-                    json.insert("lastSeen", device->lastSeen());
+            if (device->linkQuality())
+                json.insert("linkQuality", device->linkQuality());
 
-                if (device->linkQuality())
-                    json.insert("linkQuality", device->linkQuality());
+            if (!device->description().isEmpty())
+                json.insert("description", device->description());
 
-                if (!device->description().isEmpty())
-                    json.insert("description", device->description());
+            if (!device->note().isEmpty())
+                json.insert("note", device->note());
+        }
 
-                if (!device->note().isEmpty())
-                    json.insert("note", device->note());
-            }
+        if (!device->endpoints().isEmpty())
+        {
+            QJsonArray endpoints;
 
-            if (!device->endpoints().isEmpty())
+            for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
             {
-                QJsonArray endpoints;
+                const Endpoint &endpoint = it.value();
 
-                for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
+                if (endpoint->dirty())
                 {
-                    QJsonObject json;
+                    endpoint->cache() = serializeEndpoint(endpoint);
+                    endpoint->setDirty(false);
+                }
 
-                    if (!it.value()->profileId() && !it.value()->deviceId())
-                        continue;
+                if (endpoint->cache().isEmpty())
+                    continue;
 
-                    json.insert("endpointId", it.key());
-                    json.insert("profileId", it.value()->profileId());
-                    json.insert("deviceId", it.value()->deviceId());
+                endpoints.append(endpoint->cache());
+            }
 
-                    if (it.value()->colorCapabilities())
-                        json.insert("colorCapabilities", it.value()->colorCapabilities());
+            if (!endpoints.isEmpty())
+                json.insert("endpoints", endpoints);
+        }
 
-                    if (it.value()->zoneType())
-                        json.insert("zoneType", it.value()->zoneType());
+        if (!device->neighbors().isEmpty())
+        {
+            QJsonArray neighbors;
 
-                    if (!it.value()->inClusters().isEmpty())
-                    {
-                        QJsonArray inClusters;
+            for (auto it = device->neighbors().begin(); it != device->neighbors().end(); it++)
+                neighbors.append(QJsonObject {{"networkAddress", it.key()}, {"linkQuality", it.value()}});
 
-                        for (int i = 0; i < it.value()->inClusters().count(); i++)
-                            inClusters.append(it.value()->inClusters().at(i));
+            json.insert("neighbors", neighbors);
+        }
+    }
+    else
+    {
+        json.insert("name", device->name());
+        json.insert("removed", true);
+    }
 
-                        json.insert("inClusters", inClusters);
-                    }
+    return json;
+}
 
-                    if (!it.value()->outClusters().isEmpty())
-                    {
-                        QJsonArray outClusters;
+QJsonObject DeviceList::serializeEndpoint(const Endpoint &endpoint)
+{
+    QJsonObject json;
 
-                        for (int i = 0; i < it.value()->outClusters().count(); i++)
-                            outClusters.append(it.value()->outClusters().at(i));
+    if (!endpoint->profileId() && !endpoint->deviceId())
+        return json;
 
-                        json.insert("outClusters", outClusters);
-                    }
+    json.insert("endpointId", endpoint->id());
+    json.insert("profileId", endpoint->profileId());
+    json.insert("deviceId", endpoint->deviceId());
 
-                    endpoints.append(json);
-                }
+    if (endpoint->colorCapabilities())
+        json.insert("colorCapabilities", endpoint->colorCapabilities());
 
-                if (!endpoints.isEmpty())
-                    json.insert("endpoints", endpoints);
-            }
+    if (endpoint->zoneType())
+        json.insert("zoneType", endpoint->zoneType());
 
-            if (!device->neighbors().isEmpty())
-            {
-                QJsonArray neighbors;
+    if (!endpoint->inClusters().isEmpty())
+    {
+        QJsonArray inClusters;
 
-                for (auto it = device->neighbors().begin(); it != device->neighbors().end(); it++)
-                    neighbors.append(QJsonObject {{"networkAddress", it.key()}, {"linkQuality", it.value()}});
+        for (int i = 0; i < endpoint->inClusters().count(); i++)
+            inClusters.append(endpoint->inClusters().at(i));
 
-                json.insert("neighbors", neighbors);
-            }
-        }
-        else
+        json.insert("inClusters", inClusters);
+    }
+
+    if (!endpoint->outClusters().isEmpty())
+    {
+        QJsonArray outClusters;
+
+        for (int i = 0; i < endpoint->outClusters().count(); i++)
+            outClusters.append(endpoint->outClusters().at(i));
+
+        json.insert("outClusters", outClusters);
+    }
+
+    return json;
+}
+
+QJsonArray DeviceList::serializeDevices(void)
+{
+    QJsonArray array;
+
+    for (auto it = begin(); it != end(); it++)
+    {
+        const Device &device = it.value();
+        bool check = device->dirty();
+
+        for (auto it = device->endpoints().begin(); it != device->endpoints().end() && !check; it++)
+            if (it.value()->dirty())
+                check = true;
+
+        if (check)
         {
-            json.insert("name", device->name());
-            json.insert("removed", true);
+            device->cache() = serializeDevice(device);
+            device->setDirty(false);
         }
 
-        array.append(json);
+        array.append(device->cache());
     }
 
     return array;
 }
 
+QJsonObject DeviceList::serializeDatabase(void)
+{
+    return {{"devices", serializeDevices()}, {"names", m_names}, {"permitJoin", m_permitJoin}, {"timestamp", QDateTime::currentSecsSinceEpoch()}, {"version", SERVICE_VERSION}};
+}
+
 QJsonObject DeviceList::serializeProperties(void)
 {
     QJsonObject json;
@@ -1114,6 +1233,47 @@ QJsonObject DeviceList::serializeProperties(void)
     return json;
 }
 
+QString DeviceList::jsonFileName(const QFile &file)
+{
+    QFileInfo info(file);
+    return QString("%1/%2.json").arg(info.absolutePath(), info.completeBaseName());
+}
+
+bool DeviceList::readFile(QFile &file, QJsonObject &json)
+{
+    QFile legacy(jsonFileName(file));
+    QFile &source = m_cbor && !file.exists() && legacy.exists() ? legacy : file;
+    QByteArray data;
+
+    if (!source.open(QFile::ReadOnly))
+        return false;
+
+    data = source.readAll();
+    source.close();
+
+    if (data.isEmpty() || (static_cast <quint8> (data.at(0)) & 0xE0) != 0xA0)
+    {
+        json = QJsonDocument::fromJson(data).object();
+
+        if (m_cbor)
+            m_migrate = true;
+    }
+    else
+    {
+        json = QCborValue::fromCbor(data).toMap().toJsonObject();
+
+        if (!m_cbor)
+            m_migrate = true;
+    }
+
+    return true;
+}
+
+QByteArray DeviceList::encodeData(const QJsonObject &json)
+{
+    return m_cbor ? QCborValue(QCborMap::fromJsonObject(json)).toCbor() : QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
 bool DeviceList::writeFile(QFile &file, const QByteArray &data, bool sync)
 {
     bool check = true;
@@ -1140,7 +1300,7 @@ bool DeviceList::writeFile(QFile &file, const QByteArray &data, bool sync)
 
 void DeviceList::writeDatabase(void)
 {
-    QJsonObject json = {{"devices", serializeDevices()}, {"names", m_names}, {"permitJoin", m_permitJoin}, {"timestamp", QDateTime::currentSecsSinceEpoch()}, {"version", SERVICE_VERSION}};
+    QJsonObject json = serializeDatabase();
 
     m_databaseTimer->start(STORE_DATABASE_INTERVAL);
     emit statusUpdated(json);
@@ -1150,7 +1310,7 @@ void DeviceList::writeDatabase(void)
 
     m_sync = false;
 
-    if (writeFile(m_databaseFile, QJsonDocument(json).toJson(QJsonDocument::Compact), true))
+    if (writeFile(m_databaseFile, encodeData(json), true))
         return;
 
     logWarning << "Database not stored, file" << m_databaseFile.fileName() << "error:" << m_databaseFile.errorString();
@@ -1160,7 +1320,7 @@ void DeviceList::writeProperties(void)
 {
     QJsonObject json = serializeProperties();
 
-    if (writeFile(m_propertiesFile, QJsonDocument(json).toJson(QJsonDocument::Compact)))
+    if (writeFile(m_propertiesFile, encodeData(json)))
         return;
 
     logWarning << "Properties not stored, file" << m_propertiesFile.fileName() << "error:" << m_propertiesFile.errorString();
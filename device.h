@@ -5,8 +5,11 @@
 #define STORE_DATABASE_DELAY        20
 #define STORE_PROPERTIES_DELAY      1000
 
+#include <QCborMap>
+#include <QCborValue>
 #include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -32,7 +35,7 @@ class EndpointObject : public AbstractEndpointObject, public EndpointDataObject
 public:
 
     EndpointObject(quint8 id, Device device, quint16 profileId = 0, quint16 deviceId = 0) :
-        AbstractEndpointObject(id, device), EndpointDataObject(profileId, deviceId), m_timer(new QTimer(this)), m_pollInterval(0), m_pollTime(0), m_colorCapabilities(0), m_zoneType(0), m_zoneStatus(ZoneStatus::Unknown), m_descriptorReceived(false), m_updated(false) {}
+        AbstractEndpointObject(id, device), EndpointDataObject(profileId, deviceId), m_timer(new QTimer(this)), m_pollInterval(0), m_pollTime(0), m_colorCapabilities(0), m_zoneType(0), m_zoneStatus(ZoneStatus::Unknown), m_descriptorReceived(false), m_updated(false), m_dirty(true) {}
 
     inline QTimer *timer(void) { return m_timer; }
 
@@ -43,10 +46,10 @@ public:
     inline void setPollTime(qint64 value) { m_pollTime = value; }
 
     inline quint16 colorCapabilities(void) { return m_colorCapabilities; }
-    inline void setColorCapabilities(quint16 value) { m_colorCapabilities = value; }
+    inline void setColorCapabilities(quint16 value) { m_colorCapabilities = value; m_dirty = true; }
 
     inline quint16 zoneType(void) { return m_zoneType; }
-    inline void setZoneType(quint16 value) { m_zoneType = value; }
+    inline void setZoneType(quint16 value) { m_zoneType = value; m_dirty = true; }
 
     inline ZoneStatus zoneStatus(void) { return m_zoneStatus; }
     inline void setZoneStatus(ZoneStatus value) { m_zoneStatus = value; }
@@ -57,6 +60,11 @@ public:
     inline bool updated(void) { return m_updated; }
     inline void setUpdated(bool value) { m_updated = value; }
 
+    inline bool dirty(void) { return m_dirty; }
+    inline void setDirty(bool value) { m_dirty = value; }
+
+    inline QJsonObject &cache(void) { return m_cache; }
+
     inline QList <Property> &properties(void) { return m_properties; }
     inline QList <Action> &actions(void) { return m_actions; }
     inline QList <Binding> &bindings(void) { return m_bindings; }
@@ -73,7 +81,8 @@ private:
     quint16 m_colorCapabilities, m_zoneType;
     ZoneStatus m_zoneStatus;
 
-    bool m_descriptorReceived, m_updated;
+    bool m_descriptorReceived, m_updated, m_dirty;
+    QJsonObject m_cache;
 
     QList <Property> m_properties;
     QList <Action> m_actions;
@@ -83,19 +92,26 @@ private:
 
 };
 
+struct publishPolicyStruct
+{
+    qint64 interval;
+    qint64 debounce;
+    qint64 latency;
+};
+
 class DeviceObject : public AbstractDeviceObject
 {
 
 public:
 
     DeviceObject(const QByteArray &ieeeAddress, quint16 networkAddress, const QString name = QString(), bool removed = false) :
-        AbstractDeviceObject(name.isEmpty() ? ieeeAddress.toHex(':') : name), m_timer(new QTimer(this)), m_ieeeAddress(ieeeAddress), m_networkAddress(networkAddress), m_removed(removed), m_supported(false), m_descriptorReceived(false), m_endpointsReceived(false), m_interviewFinished(false), m_logicalType(LogicalType::EndDevice), m_manufacturerCode(0), m_powerSource(POWER_SOURCE_UNKNOWN), m_joinTime(0), m_lastSeen(0), m_linkQuality(0) {}
+        AbstractDeviceObject(name.isEmpty() ? ieeeAddress.toHex(':') : name), m_timer(new QTimer(this)), m_ieeeAddress(ieeeAddress), m_networkAddress(networkAddress), m_removed(removed), m_supported(false), m_descriptorReceived(false), m_endpointsReceived(false), m_interviewFinished(false), m_logicalType(LogicalType::EndDevice), m_manufacturerCode(0), m_powerSource(POWER_SOURCE_UNKNOWN), m_joinTime(0), m_lastSeen(0), m_linkQuality(0), m_publishPolicy({0, 0, 0}), m_dirty(true) {}
 
     inline QTimer *timer(void) { return m_timer; }
     inline QByteArray ieeeAddress(void) { return m_ieeeAddress; }
 
     inline quint16 networkAddress(void) { return m_networkAddress; }
-    inline void setNetworkAddress(quint16 value) { m_networkAddress = value; }
+    inline void setNetworkAddress(quint16 value) { m_networkAddress = value; m_dirty = true; }
 
     inline bool descriptorReceived(void) { return m_descriptorReceived; }
     inline void setDescriptorReceived(void) { m_descriptorReceived = true; }
@@ -104,13 +120,13 @@ public:
     inline void setEndpointsReceived(void) { m_endpointsReceived = true; }
 
     inline bool interviewFinished(void) { return m_interviewFinished; }
-    inline void setInterviewFinished(void) { m_interviewFinished = true; }
+    inline void setInterviewFinished(void) { m_interviewFinished = true; m_dirty = true; }
 
     inline bool removed(void) { return m_removed; }
-    inline void setRemoved(bool value) { m_removed = value; }
+    inline void setRemoved(bool value) { m_removed = value; m_dirty = true; }
 
     inline bool supported(void) { return m_supported; }
-    inline void setSupported(bool value) { m_supported = value; }
+    inline void setSupported(bool value) { m_supported = value; m_dirty = true; }
 
     inline quint8 interviewEndpointId(void) { return m_interviewEndpointId; }
     inline void setInterviewEndpointId(quint8 value) { m_interviewEndpointId = value; }
@@ -119,30 +135,39 @@ public:
     inline void setLqiRequestIndex(quint8 value) { m_lqiRequestIndex = value; }
 
     inline LogicalType logicalType(void) { return m_logicalType; }
-    inline void setLogicalType(LogicalType value) { m_logicalType = value; }
+    inline void setLogicalType(LogicalType value) { m_logicalType = value; m_dirty = true; }
 
     inline quint16 manufacturerCode(void) { return m_manufacturerCode; }
-    inline void setManufacturerCode(quint16 value) { m_manufacturerCode = value; }
+    inline void setManufacturerCode(quint16 value) { m_manufacturerCode = value; m_dirty = true; }
 
     inline bool batteryPowered(void) { return m_powerSource != POWER_SOURCE_MAINS && m_powerSource != POWER_SOURCE_DC; }
     inline quint8 powerSource(void) { return m_powerSource; }
-    inline void setPowerSource(quint8 value) { m_powerSource = value; }
+    inline void setPowerSource(quint8 value) { m_powerSource = value; m_dirty = true; }
 
     inline QString firmware(void) { return m_firmware; }
-    inline void setFirmware(const QString &value) { m_firmware = value; }
+    inline void setFirmware(const QString &value) { m_firmware = value; m_dirty = true; }
 
     inline qint64 joinTime(void) { return m_joinTime; }
     inline void updateJoinTime(void) { m_joinTime = QDateTime::currentMSecsSinceEpoch(); }
 
     inline qint64 lastSeen(void) { return m_lastSeen; }
-    inline void setLastSeen(qint64 value) { m_lastSeen = value; }
-    inline void updateLastSeen(void) { m_lastSeen = QDateTime::currentSecsSinceEpoch(); }
+    inline void setLastSeen(qint64 value) { m_lastSeen = value; m_dirty = true; }
+    inline void updateLastSeen(void) { m_lastSeen = QDateTime::currentSecsSinceEpoch(); m_dirty = true; }
 
     inline quint8 linkQuality(void) { return m_linkQuality; }
-    inline void setLinkQuality(quint8 value) { m_linkQuality = value; }
+    inline void setLinkQuality(quint8 value) { m_linkQuality = value; m_dirty = true; }
 
     inline QMap <quint16, quint8> &neighbors(void) { return m_neighbors; }
 
+    inline publishPolicyStruct publishPolicy(void) { return m_publishPolicy; }
+    inline void setPublishPolicy(const publishPolicyStruct &value) { m_publishPolicy = value; }
+    inline QMap <QString, publishPolicyStruct> &publishPolicies(void) { return m_publishPolicies; }
+
+    inline bool dirty(void) { return m_dirty; }
+    inline void setDirty(bool value) { m_dirty = value; }
+
+    inline QJsonObject &cache(void) { return m_cache; }
+
 private:
 
     QTimer *m_timer;
@@ -163,6 +188,12 @@ private:
 
     QMap <quint16, quint8> m_neighbors;
 
+    publishPolicyStruct m_publishPolicy;
+    QMap <QString, publishPolicyStruct> m_publishPolicies;
+
+    bool m_dirty;
+    QJsonObject m_cache;
+
 };
 
 class DeviceList : public QObject, public QMap <QByteArray, Device>
@@ -183,6 +214,7 @@ public:
     void init(void);
     void storeDatabase(void);
     void storeProperties(void);
+    void exportDatabase(void);
 
     Device byName(const QString &name);
     Device byNetwork(quint16 networkAddress);
@@ -206,7 +238,7 @@ private:
 
     QFile m_databaseFile, m_propertiesFile, m_optionsFile;
     QDir m_externalDir, m_libraryDir;
-    bool m_names, m_permitJoin, m_sync;
+    bool m_names, m_permitJoin, m_sync, m_cbor, m_migrate;
 
     QMap <QString, QVariant> m_exposeOptions;
     QList <QString> m_specialExposes;
@@ -214,9 +246,17 @@ private:
     void unserializeDevices(const QJsonArray &devices);
     void unserializeProperties(const QJsonObject &properties);
 
+    QJsonObject serializeDevice(const Device &device);
+    QJsonObject serializeEndpoint(const Endpoint &endpoint);
+
     QJsonArray serializeDevices(void);
+    QJsonObject serializeDatabase(void);
     QJsonObject serializeProperties(void);
 
+    QString jsonFileName(const QFile &file);
+    bool readFile(QFile &file, QJsonObject &json);
+
+    QByteArray encodeData(const QJsonObject &json);
     bool writeFile(QFile &file, const QByteArray &data, bool sync = false);
 
 private slots:
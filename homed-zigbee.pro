@@ -17,6 +17,7 @@ HEADERS += \
     controller.h \
     device.h \
     ezsp.h \
+    ota.h \
     poll.h \
     properties/common.h \
     properties/efekta.h \
@@ -26,7 +27,10 @@ HEADERS += \
     properties/ptvo.h \
     properties/tuya.h \
     property.h \
+    registry.h \
     reporting.h \
+    topology.h \
+    writer.h \
     zcl.h \
     zigate.h \
     zigbee.h \
@@ -46,6 +50,7 @@ SOURCES += \
     controller.cpp \
     device.cpp \
     ezsp.cpp \
+    ota.cpp \
     poll.cpp \
     properties/common.cpp \
     properties/efekta.cpp \
@@ -56,6 +61,8 @@ SOURCES += \
     properties/tuya.cpp \
     property.cpp \
     reporting.cpp \
+    topology.cpp \
+    writer.cpp \
     zcl.cpp \
     zigate.cpp \
     zigbee.cpp \
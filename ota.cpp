@@ -0,0 +1,134 @@
+#include <QtEndian>
+#include <QDir>
+#include "logger.h"
+#include "ota.h"
+
+OtaImageObject::OtaImageObject(const QString &fileName) : m_file(fileName), m_data(nullptr), m_size(0)
+{
+    if (!m_file.open(QFile::ReadOnly))
+        return;
+
+    if (m_file.size() < static_cast <qint64> (sizeof(otaFileHeaderStruct)))
+    {
+        m_file.close();
+        return;
+    }
+
+    m_data = m_file.map(0, m_file.size());
+
+    if (!m_data)
+    {
+        m_file.close();
+        return;
+    }
+
+    m_size = m_file.size();
+}
+
+OtaImageObject::~OtaImageObject(void)
+{
+    if (!m_data)
+        return;
+
+    m_file.unmap(m_data);
+    m_file.close();
+}
+
+void OtaSessionObject::startPage(quint8 endpointId, quint8 transactionId, const otaImagePageRequestStruct &request)
+{
+    start();
+
+    m_pageMode = true;
+    m_pageEndpointId = endpointId;
+    m_pageTransactionId = transactionId;
+    m_pageRequest = request;
+
+    m_pageOffset = qFromLittleEndian(request.fileOffset);
+    m_pageEnd = static_cast <quint32> (qMin <qint64> (static_cast <qint64> (m_pageOffset) + qFromLittleEndian(request.pageSize), m_image->size()));
+    m_pageTime = 0;
+}
+
+void OtaSessionObject::advancePage(quint32 size)
+{
+    m_pageOffset = size ? m_pageOffset + size : m_pageEnd;
+    m_pageTime = QDateTime::currentMSecsSinceEpoch() + qMax <quint16> (qFromLittleEndian(m_pageRequest.responseSpacing), OTA_PAGE_MIN_SPACING);
+}
+
+OtaRepository::OtaRepository(const QString &path, QObject *parent) : QObject(parent), m_watcher(new QFileSystemWatcher(this)), m_path(path)
+{
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &OtaRepository::scan);
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, this, &OtaRepository::scan);
+    m_watcher->addPath(m_path);
+    scan();
+}
+
+QString OtaRepository::find(quint16 manufacturerCode, quint16 imageType, quint32 fileVersion, bool exact)
+{
+    QString fileName;
+    quint32 version = fileVersion;
+
+    for (auto it = m_index.begin(); it != m_index.end(); it++)
+    {
+        if (it.value().manufacturerCode != manufacturerCode || it.value().imageType != imageType)
+            continue;
+
+        if (exact)
+        {
+            if (it.value().fileVersion == fileVersion)
+                return it.key();
+
+            continue;
+        }
+
+        if (it.value().fileVersion <= version)
+            continue;
+
+        fileName = it.key();
+        version = it.value().fileVersion;
+    }
+
+    return fileName;
+}
+
+void OtaRepository::scan(void)
+{
+    QFileInfoList list = QDir(m_path).entryInfoList(QDir::Files);
+    QMap <QString, otaIndexStruct> index;
+    int count = 0;
+
+    for (int i = 0; i < list.count(); i++)
+    {
+        const QFileInfo &info = list.at(i);
+        auto it = m_index.find(info.filePath());
+        otaFileHeaderStruct header;
+        QFile file(info.filePath());
+
+        if (!m_watcher->files().contains(info.filePath()))
+            m_watcher->addPath(info.filePath());
+
+        if (it != m_index.end() && it.value().modified == info.lastModified().toMSecsSinceEpoch() && it.value().size == info.size())
+        {
+            index.insert(it.key(), it.value());
+            continue;
+        }
+
+        if (!file.open(QFile::ReadOnly) || file.read(reinterpret_cast <char*> (&header), sizeof(header)) != sizeof(header) || qFromLittleEndian(header.fileIdentifier) != OTA_FILE_IDENTIFIER)
+            continue;
+
+        index.insert(info.filePath(), {info.lastModified().toMSecsSinceEpoch(), info.size(), qFromLittleEndian(header.manufacturerCode), qFromLittleEndian(header.imageType), qFromLittleEndian(header.fileVersion)});
+        count++;
+    }
+
+    if (count || index.count() != m_index.count())
+        logInfo << "OTA repository" << m_path << "indexed," << index.count() << "images available";
+
+    m_index = index;
+}
+
+QByteArray OtaImageObject::block(quint32 offset, quint8 size)
+{
+    if (offset >= m_size || m_file.size() < m_size)
+        return QByteArray();
+
+    return QByteArray(reinterpret_cast <const char*> (m_data + offset), static_cast <int> (qMin <qint64> (size, m_size - offset)));
+}
@@ -0,0 +1,133 @@
+#ifndef OTA_H
+#define OTA_H
+
+#define OTA_FILE_IDENTIFIER             0x0BEEF11E
+#define OTA_PAGE_MIN_SPACING            20
+#define OTA_SESSION_TIMEOUT             600000
+#define OTA_NOTIFY_TIMEOUT              86400000
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QMap>
+#include <QSharedPointer>
+#include "zcl.h"
+
+class OtaImageObject;
+typedef QSharedPointer <OtaImageObject> OtaImage;
+
+class OtaSessionObject;
+typedef QSharedPointer <OtaSessionObject> OtaSession;
+
+class OtaImageObject
+{
+
+public:
+
+    OtaImageObject(const QString &fileName);
+    ~OtaImageObject(void);
+
+    inline QString fileName(void) { return m_file.fileName(); }
+    inline bool valid(void) { return m_data != nullptr; }
+
+    inline const otaFileHeaderStruct *header(void) { return reinterpret_cast <const otaFileHeaderStruct*> (m_data); }
+    inline qint64 size(void) { return m_size; }
+
+    QByteArray block(quint32 offset, quint8 size);
+
+private:
+
+    QFile m_file;
+    uchar *m_data;
+    qint64 m_size;
+
+};
+
+class OtaSessionObject
+{
+
+public:
+
+    OtaSessionObject(const OtaImage &image, bool force, quint16 blockPeriod) :
+        m_image(image), m_force(force), m_progress(-1), m_blockPeriod(blockPeriod), m_started(0), m_time(QDateTime::currentMSecsSinceEpoch()), m_pageMode(false), m_pageOffset(0), m_pageEnd(0), m_pageTime(0) {}
+
+    inline OtaImage image(void) { return m_image; }
+    inline bool force(void) { return m_force; }
+
+    inline int progress(void) { return m_progress; }
+    inline void setProgress(int value) { m_progress = value; }
+
+    inline quint16 blockPeriod(void) { return m_blockPeriod; }
+    inline void setBlockPeriod(quint16 value) { m_blockPeriod = value; }
+
+    inline qint64 started(void) { return m_started; }
+    inline bool pageMode(void) { return m_pageMode; }
+    inline void start(void) { if (!m_started) m_started = QDateTime::currentMSecsSinceEpoch(); }
+
+    inline qint64 time(void) { return m_time; }
+    inline void setTime(qint64 value) { m_time = value; }
+    inline bool expired(qint64 time) { return time - m_time > (m_started ? OTA_SESSION_TIMEOUT : OTA_NOTIFY_TIMEOUT); }
+
+    inline quint8 pageEndpointId(void) { return m_pageEndpointId; }
+    inline quint8 pageTransactionId(void) { return m_pageTransactionId; }
+    inline const otaImagePageRequestStruct &pageRequest(void) { return m_pageRequest; }
+
+    inline quint32 pageOffset(void) { return m_pageOffset; }
+    inline bool pageActive(void) { return m_pageOffset < m_pageEnd; }
+
+    inline qint64 pageTime(void) { return m_pageTime; }
+    inline void setPageTime(qint64 value) { m_pageTime = value; }
+
+    void startPage(quint8 endpointId, quint8 transactionId, const otaImagePageRequestStruct &request);
+    void advancePage(quint32 size);
+
+private:
+
+    OtaImage m_image;
+    bool m_force;
+    int m_progress;
+    quint16 m_blockPeriod;
+
+    qint64 m_started, m_time;
+    bool m_pageMode;
+
+    quint8 m_pageEndpointId, m_pageTransactionId;
+    otaImagePageRequestStruct m_pageRequest;
+    quint32 m_pageOffset, m_pageEnd;
+    qint64 m_pageTime;
+
+};
+
+struct otaIndexStruct
+{
+    qint64  modified;
+    qint64  size;
+    quint16 manufacturerCode;
+    quint16 imageType;
+    quint32 fileVersion;
+};
+
+class OtaRepository : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    OtaRepository(const QString &path, QObject *parent);
+
+    QString find(quint16 manufacturerCode, quint16 imageType, quint32 fileVersion, bool exact = false);
+
+private:
+
+    QFileSystemWatcher *m_watcher;
+    QString m_path;
+
+    QMap <QString, otaIndexStruct> m_index;
+
+private slots:
+
+    void scan(void);
+
+};
+
+#endif
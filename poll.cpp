@@ -2,8 +2,8 @@
 
 void PollObject::registerMetaTypes(void)
 {
-    qRegisterMetaType <Polls::Energy>   ("energyPoll");
-    qRegisterMetaType <Polls::Voltage>  ("voltagePoll");
-    qRegisterMetaType <Polls::Current>  ("currentPoll");
-    qRegisterMetaType <Polls::Power>    ("powerPoll");
+    Registry <PollObject>::add <Polls::Energy>  ("energy");
+    Registry <PollObject>::add <Polls::Voltage> ("voltage");
+    Registry <PollObject>::add <Polls::Current> ("current");
+    Registry <PollObject>::add <Polls::Power>   ("power");
 }
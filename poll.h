@@ -2,6 +2,7 @@
 #define POLL_H
 
 #include <QSharedPointer>
+#include "registry.h"
 #include "zcl.h"
 
 class PollObject;
@@ -25,11 +25,10 @@ void Properties::DeviceTemperature::parseAttribte(quint16, quint16 attributeId,
 {
     qint16 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void Properties::Status::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
@@ -52,22 +51,20 @@ void Properties::AnalogInput::parseAttribte(quint16, quint16 attributeId, const
 {
     float value = 0;
 
-    if (attributeId != 0x0055 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0055 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void Properties::AnalogOutput::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     float value = 0;
 
-    if (attributeId != 0x0055 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0055 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void Properties::CoverPosition::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
@@ -107,11 +104,10 @@ void Properties::Thermostat::parseAttribte(quint16, quint16 attributeId, const Q
         {
             qint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert(attributeId ? "targetTemperature" : "temperature", qFromLittleEndian(value) / 100.0);
+            map.insert(attributeId ? "targetTemperature" : "temperature", value / 100.0);
             break;
         }
 
@@ -167,19 +163,17 @@ void Properties::ColorXY::parseAttribte(quint16, quint16 attributeId, const QByt
 {
     quint16 value = 0;
 
-    if (static_cast <size_t> (data.length()) > sizeof(value))
+    if (!zclValue(data, value))
         return;
 
     switch (attributeId)
     {
         case 0x0003:
-            memcpy(&value, data.constData(), data.length());
-            m_colorX = qFromLittleEndian(value);
+            m_colorX = value;
             break;
 
         case 0x0004:
-            memcpy(&value, data.constData(), data.length());
-            m_colorY = qFromLittleEndian(value);
+            m_colorY = value;
             break;
     }
 
@@ -192,57 +186,52 @@ void Properties::ColorXY::parseAttribte(quint16, quint16 attributeId, const QByt
 
 void Properties::ColorTemperature::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
-    qint16 value = 0;
+    quint16 value = 0;
 
-    if (attributeId != 0x0007 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0007 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void Properties::Illuminance::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     quint16 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = option().toMap().value("raw").toBool() ? qFromLittleEndian(value) : static_cast <quint32> (value ? pow(10, (qFromLittleEndian(value) - 1) / 10000.0) : 0);
+    m_value = option().toMap().value("raw").toBool() ? value : static_cast <quint32> (value ? pow(10, (value - 1) / 10000.0) : 0);
 }
 
 void Properties::Temperature::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     qint16 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / 100.0;
+    m_value = value / 100.0;
 }
 
 void Properties::Pressure::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     qint16 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / 10.0;
+    m_value = value / 10.0;
 }
 
 void Properties::Humidity::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     quint16 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / option("humidityDivider", 100).toDouble();
+    m_value = value / option("humidityDivider", 100).toDouble();
 }
 
 void Properties::Occupancy::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
@@ -262,33 +251,29 @@ void Properties::OccupancyTimeout::parseAttribte(quint16, quint16 attributeId, c
 {
     quint16 value;
 
-    if (attributeId != 0x0010 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0010 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void Properties::Moisture::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     quint16 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / 100.0;
+    m_value = value / 100.0;
 }
 
 void Properties::CO2::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     float value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    value = qFromLittleEndian(value);
     m_value = round(value < 1 ? value * 1000000 : value);
 }
 
@@ -296,59 +281,55 @@ void Properties::PM25::parseAttribte(quint16, quint16 attributeId, const QByteAr
 {
     float value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void Properties::Energy::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     double divider = option("energyDivider", 1).toDouble();
-    qint64 value = 0;
+    quint64 value = 0;
 
-    if (attributeId != 0x0000 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0000 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / divider;
+    m_value = value / divider;
 }
 
 void Properties::Voltage::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     double divider = option("voltageDivider", 1).toDouble();
-    qint16 value = 0;
+    quint16 value = 0;
 
-    if (attributeId != 0x0505 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0505 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / divider;
+    m_value = value / divider;
 }
 
 void Properties::Current::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     double divider = option("currentDivider", 1).toDouble();
-    qint16 value = 0;
+    quint16 value = 0;
 
-    if (attributeId != 0x0508 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0508 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / divider;
+    m_value = value / divider;
 }
 
 void Properties::Power::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     double divider = option("powerDivider", 1).toDouble();
-    qint16 value = 0;
+    quint16 value = 0;
 
-    if (attributeId != 0x050B || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x050B || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) / divider;
+    // active power is int16, but some devices report it with a narrower unsigned type
+    m_value = (data.length() < static_cast <int> (sizeof(value)) ? value : static_cast <qint16> (value)) / divider;
 }
 
 void Properties::Scene::parseCommand(quint16, quint8 commandId, const QByteArray &payload)
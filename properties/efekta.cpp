@@ -6,11 +6,10 @@ void PropertiesEfekta::ReportingDelay::parseAttribte(quint16, quint16 attributeI
 {
     quint16 value = 0;
 
-    if (attributeId != 0x0201 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0201 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void PropertiesEfekta::TemperatureSettings::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
@@ -25,12 +24,9 @@ void PropertiesEfekta::TemperatureSettings::parseAttribte(quint16, quint16 attri
         {
             qint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            value = qFromLittleEndian(value);
-
             switch (attributeId)
             {
                 case 0x0210: map.insert("temperatureOffset", value / 10.0); break;
@@ -62,11 +58,10 @@ void PropertiesEfekta::HumiditySettings::parseAttribte(quint16, quint16 attribut
         {
             qint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert("humidityOffset", qFromLittleEndian(value));
+            map.insert("humidityOffset", value);
             break;
         }
 
@@ -101,12 +96,9 @@ void PropertiesEfekta::CO2Settings::parseAttribte(quint16, quint16 attributeId,
         {
             uint16_t value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            value = qFromLittleEndian(value);
-
             switch (attributeId)
             {
                 case 0x0205: map.insert("altitude", value); break;
@@ -156,11 +148,10 @@ void PropertiesEfekta::PMSensor::parseAttribte(quint16, quint16 attributeId, con
         {
             float value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert(attributeId == 0x00C8 ? "pm1" : "pm10", qFromLittleEndian(value));
+            map.insert(attributeId == 0x00C8 ? "pm1" : "pm10", value);
             break;
         }
 
@@ -170,12 +161,9 @@ void PropertiesEfekta::PMSensor::parseAttribte(quint16, quint16 attributeId, con
         {
             quint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            value = qFromLittleEndian(value);
-
             switch (attributeId)
             {
                 case 0x0201: map.insert("readInterval", value); break;
@@ -207,11 +195,10 @@ void PropertiesEfekta::VOCSensor::parseAttribte(quint16, quint16 attributeId, co
         {
             float value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert(endpointId() == 0x01 ? "voc" : "eco2", qFromLittleEndian(value));
+            map.insert(endpointId() == 0x01 ? "voc" : "eco2", value);
             break;
         }
 
@@ -220,11 +207,10 @@ void PropertiesEfekta::VOCSensor::parseAttribte(quint16, quint16 attributeId, co
         {
             quint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert(attributeId == 0x0221 ? "vocHigh" : "vocLow", qFromLittleEndian(value));
+            map.insert(attributeId == 0x0221 ? "vocHigh" : "vocLow", value);
             break;
         }
 
@@ -4,25 +4,28 @@
 
 void PropertiesLUMI::Data::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
-    QMap <QString, QVariant> map = m_value.toMap();
+    if (m_value.toMap() != m_map)
+        m_map = m_value.toMap();
 
     if (attributeId == 0x00F7 || attributeId == 0xFF01)
     {
-        for (quint8 i = 0; i < static_cast <quint8> (data.length()); i++)
+        int i = 0;
+
+        while (i + 2 < data.length())
         {
-            quint8 offset = i + 2, size = zclDataSize(static_cast <quint8> (data.at(i + 1)), data, &offset);
+            int offset = i + 2, size = zclDataSize(static_cast <quint8> (data.at(i + 1)), data, &offset);
 
-            if (!size)
+            if (!size || offset + size > data.length())
                 break;
 
-            parseData(static_cast <quint8> (data.at(i)), data.mid(offset, size), map);
-            i += size + 1;
+            parseData(static_cast <quint8> (data.at(i)), QByteArray::fromRawData(data.constData() + offset, size), m_map);
+            i = offset + size;
         }
     }
     else
-        parseData(attributeId, data, map);
+        parseData(attributeId, data, m_map);
 
-    m_value = map.isEmpty() ? QVariant() : map;
+    m_value = m_map.isEmpty() ? QVariant() : m_map;
 }
 
 void PropertiesLUMI::Data::resetValue(void)
@@ -35,9 +38,19 @@ void PropertiesLUMI::Data::resetValue(void)
     m_value = map;
 }
 
+void PropertiesLUMI::Data::updateValue(QMap <QString, QVariant> &map, const QString &key, const QVariant &value)
+{
+    auto it = map.constFind(key);
+
+    if (it != map.constEnd() && it.value() == value)
+        return;
+
+    map.insert(key, value);
+}
+
 void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data, QMap <QString, QVariant> &map)
 {
-    if (m_multiple && dataPoint != 0x0200)
+    if ((m_multiple && dataPoint != 0x0200) || data.isEmpty())
         return;
 
     switch (dataPoint)
@@ -46,11 +59,10 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
         {
             quint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 break;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert("battery", percentage(2850, 3000, qFromLittleEndian(value)));
+            updateValue(map, "battery", percentage(2850, 3000, value));
             break;
         }
 
@@ -61,7 +73,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
             if (list.contains(modelName()))
                 break;
 
-            map.insert("temperature", static_cast <qint8> (data.at(0)));
+            updateValue(map, "temperature", static_cast <qint8> (data.at(0)));
             break;
         }
 
@@ -69,11 +81,10 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
         {
             quint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 break;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert("outageCount", qFromLittleEndian(value) - 1);
+            updateValue(map, "outageCount", value - 1);
             break;
         }
 
@@ -84,7 +95,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
             if (!list.contains(modelName()))
                 break;
 
-            map.insert("operationMode", enumValue("operationMode", static_cast <quint8> (data.at(0))));
+            updateValue(map, "operationMode", enumValue("operationMode", static_cast <quint8> (data.at(0))));
             break;
         }
 
@@ -92,7 +103,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
         case 0x0142:
         {
             if (modelName() == "lumi.motion.ac01")
-                map.insert("occupancy", data.at(0) ? true : false);
+                updateValue(map, "occupancy", data.at(0) ? true : false);
 
             break;
         }
@@ -106,11 +117,11 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
 
             if (dataPoint != 0x0066 ? dataPoint != 0x010C : version() < 50)
             {
-                map.insert("event", enumValue("event", static_cast <quint8> (data.at(0))));
-                map.insert("occupancy", data.at(0) != 0x01 ? true : false);
+                updateValue(map, "event", enumValue("event", static_cast <quint8> (data.at(0))));
+                updateValue(map, "occupancy", data.at(0) != 0x01 ? true : false);
             }
             else
-                map.insert("sensitivityMode", enumValue("sensitivityMode", static_cast <quint8> (data.at(0))));
+                updateValue(map, "sensitivityMode", enumValue("sensitivityMode", static_cast <quint8> (data.at(0))));
 
             break;
         }
@@ -121,7 +132,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
             if (modelName() != "lumi.motion.ac01")
                 break;
 
-            map.insert("detectionMode", enumValue("detectionMode", static_cast <quint8> (data.at(0))));
+            updateValue(map, "detectionMode", enumValue("detectionMode", static_cast <quint8> (data.at(0))));
             break;
         }
 
@@ -131,7 +142,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
             if (modelName() != "lumi.motion.ac01")
                 break;
 
-            map.insert("distanceMode", enumValue("distanceMode", static_cast <quint8> (data.at(0))));
+            updateValue(map, "distanceMode", enumValue("distanceMode", static_cast <quint8> (data.at(0))));
             break;
         }
 
@@ -139,11 +150,10 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
         {
             float value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 break;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert("energy", round(qFromLittleEndian(value) * 100) / 100);
+            updateValue(map, "energy", round(value * 100) / 100);
             break;
         }
 
@@ -155,7 +165,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
                 break;
 
             memcpy(&value, data.constData(),  data.length());
-            map.insert("voltage", round(qFromLittleEndian(value)) / 10);
+            updateValue(map, "voltage", round(qFromLittleEndian(value)) / 10);
             break;
         }
 
@@ -167,7 +177,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
                 break;
 
             memcpy(&value, data.constData(),  data.length());
-            map.insert("current", modelName() == "lumi.relay.c2acn01" ? qFromLittleEndian(value) : round(qFromLittleEndian(value)) / 1000);
+            updateValue(map, "current", modelName() == "lumi.relay.c2acn01" ? qFromLittleEndian(value) : round(qFromLittleEndian(value)) / 1000);
             break;
         }
 
@@ -175,17 +185,16 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
         {
             float value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 break;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert("power", round(qFromLittleEndian(value) * 100) / 100);
+            updateValue(map, "power", round(value * 100) / 100);
             break;
         }
 
         case 0x00F0:
         {
-            map.insert("indicatorMode", enumValue("indicatorMode", static_cast <quint8> (data.at(0))));
+            updateValue(map, "indicatorMode", enumValue("indicatorMode", static_cast <quint8> (data.at(0))));
             break;
         }
 
@@ -193,13 +202,11 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
         {
             quint32 value = 0;
 
-            if (modelName() != "lumi.motion.ac02" || static_cast <size_t> (data.length()) > sizeof(value))
+            if (modelName() != "lumi.motion.ac02" || !zclValue(data, value))
                 break;
 
-            memcpy(&value, data.constData(), data.length());
-            value = qFromLittleEndian(value);
-            map.insert("illuminance", (value > 130536 ? 0 : value & 0xFFFF));
-            map.insert("occupancy", true);
+            updateValue(map, "illuminance", (value > 130536 ? 0 : value & 0xFFFF));
+            updateValue(map, "occupancy", true);
             break;
         }
 
@@ -210,14 +217,14 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
             if (!m_multiple && list.contains(modelName()))
                 break;
 
-            map.insert("switchMode", enumValue("switchMode", static_cast <quint8> (data.at(0))));
+            updateValue(map, "switchMode", enumValue("switchMode", static_cast <quint8> (data.at(0))));
             break;
         }
 
         case 0x0201:
         case 0xFF19:
         {
-            map.insert("statusMemory", data.at(0) ? true : false);
+            updateValue(map, "statusMemory", data.at(0) ? true : false);
             break;
         }
 
@@ -229,7 +236,7 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
                 break;
 
             memcpy(&value, data.constData() + 5, sizeof(value));
-            map.insert("battery", percentage(2850, 3000, qFromLittleEndian(value)));
+            updateValue(map, "battery", percentage(2850, 3000, qFromLittleEndian(value)));
             break;
         }
 
@@ -240,9 +247,9 @@ void PropertiesLUMI::Data::parseData(quint16 dataPoint, const QByteArray &data,
 
             switch (static_cast <quint8> (data.at(0)))
             {
-                case 0x01: map.insert("sensitivityMode", "high"); break;
-                case 0x0B: map.insert("sensitivityMode", "medium"); break;
-                case 0x15: map.insert("sensitivityMode", "low"); break;
+                case 0x01: updateValue(map, "sensitivityMode", "high"); break;
+                case 0x0B: updateValue(map, "sensitivityMode", "medium"); break;
+                case 0x15: updateValue(map, "sensitivityMode", "low"); break;
             }
         }
     }
@@ -282,11 +289,10 @@ void PropertiesLUMI::Power::parseAttribte(quint16, quint16 attributeId, const QB
 {
     float value = 0;
 
-    if (attributeId != 0x0055 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0055 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value);
+    m_value = value;
 }
 
 void PropertiesLUMI::Cover::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
@@ -294,12 +300,9 @@ void PropertiesLUMI::Cover::parseAttribte(quint16, quint16 attributeId, const QB
     QMap <QString, QVariant> map;
     float value = 0;
 
-    if (attributeId != 0x0055 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0055 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    value = qFromLittleEndian(value);
-
     if (!option("invertCover").toBool())
         value = 100 - value;
 
@@ -353,23 +356,19 @@ void PropertiesLUMI::CubeRotation::parseAttribte(quint16, quint16 attributeId, c
 {
     float value = 0;
 
-    if (attributeId != 0x0055 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0055 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    m_value = qFromLittleEndian(value) < 0 ? "rotateLeft" : "rotateRight";
+    m_value = value < 0 ? "rotateLeft" : "rotateRight";
 }
 
 void PropertiesLUMI::CubeMovement::parseAttribte(quint16, quint16 attributeId, const QByteArray &data)
 {
     quint16 value = 0;
 
-    if (attributeId != 0x0055 || static_cast <size_t> (data.length()) > sizeof(value))
+    if (attributeId != 0x0055 || !zclValue(data, value))
         return;
 
-    memcpy(&value, data.constData(), data.length());
-    value = qFromLittleEndian(value);
-
     if (!value)
         m_value = "shake";
     else if (value == 2)
@@ -396,12 +395,9 @@ void PropertiesLUMI::Vibration::parseAttribte(quint16, quint16 attributeId, cons
         {
             quint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            value = qFromLittleEndian(value);
-
             switch (value)
             {
                 case 0x0001: map.insert("event", "vibration"); break;
@@ -419,11 +415,10 @@ void PropertiesLUMI::Vibration::parseAttribte(quint16, quint16 attributeId, cons
         {
             quint16 value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            map.insert("angle", qFromLittleEndian(value));
+            map.insert("angle", value);
             break;
         }
 
@@ -440,12 +435,9 @@ void PropertiesLUMI::Vibration::parseAttribte(quint16, quint16 attributeId, cons
             quint64 value = 0;
             qint16 x, y, z;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            value = qFromLittleEndian(value);
-
             x = static_cast <qint16> (value & 0xFFFF);
             y = static_cast <qint16> (value >> 16 & 0xFFFF);
             z = static_cast <qint16> (value >> 32 & 0xFFFF);
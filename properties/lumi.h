@@ -17,6 +17,9 @@ namespace PropertiesLUMI
 
     private:
 
+        QMap <QString, QVariant> m_map;
+
+        void updateValue(QMap <QString, QVariant> &map, const QString &key, const QVariant &value);
         void parseData(quint16 dataPoint, const QByteArray &data, QMap <QString, QVariant> &map);
 
     };
@@ -17,11 +17,10 @@ void PropertiesPTVO::AnalogInput::parseAttribte(quint16, quint16 attributeId, co
         {
             float value = 0;
 
-            if (static_cast <size_t> (data.length()) > sizeof(value))
+            if (!zclValue(data, value))
                 return;
 
-            memcpy(&value, data.constData(), data.length());
-            (m_unit.isEmpty() ? m_value : m_buffer) = qFromLittleEndian(value) / option(QString(m_name).append("Divider"), 1).toDouble();
+            (m_unit.isEmpty() ? m_value : m_buffer) = value / option(QString(m_name).append("Divider"), 1).toDouble();
             break;
         }
 
@@ -54,34 +54,73 @@ QVariant PropertiesTUYA::Data::parseData(const tuyaHeaderStruct *header, const Q
     return QVariant();
 }
 
-void PropertiesTUYA::DataPoints::update(quint8 dataPoint, const QVariant &data)
+void PropertiesTUYA::DataPoints::setup(void)
 {
-    QMap <QString, QVariant> map = m_value.toMap();
-    QList <QVariant> list = option().toMap().value(QString::number(dataPoint)).toList();
-    QList <QString> types = {"raw", "bool", "value", "enum"};
+    QMap <QString, QVariant> dataPoints = option().toMap();
+    QList <QString> types = {"raw", "bool", "value", "enum"}, list = {"_TZE200_bcusnqt8", "_TZE200_lsanae15", "_TZE204_lsanae15"};
+
+    m_dataPoints.clear();
+    m_electricity = list.contains(manufacturerName());
 
-    for (int i = 0; i < list.count(); i++)
+    for (auto it = dataPoints.begin(); it != dataPoints.end(); it++)
     {
-        QMap <QString, QVariant> item = list.at(i).toMap(), options;
-        QString name = item.value("name").toString();
+        QList <QVariant> items = it.value().toList();
+        QList <dataPointStruct> &dataPoint = m_dataPoints[static_cast <quint8> (it.key().toInt())];
+
+        for (int i = 0; i < items.count(); i++)
+        {
+            QMap <QString, QVariant> item = items.at(i).toMap(), options;
+            dataPointStruct data;
+            int type;
+
+            data.name = item.value("name").toString();
 
-        if(name.isEmpty())
-            continue;
+            if (data.name.isEmpty())
+                continue;
 
-        options = option(name).toMap();
+            options = option(data.name).toMap();
+            type = types.indexOf(item.value("type").toString());
+
+            data.type = type < 0 ? DataPointType::Constant : static_cast <DataPointType> (type);
+            data.invert = item.value("invert").toBool();
+            data.round = item.value("round").toBool();
+            data.divider = item.value("divider", 1).toDouble() * item.value("propertyDivider", 1).toDouble();
+            data.offset = item.value("offset").toDouble();
+            data.min = options.value("min").toDouble(&data.hasMin);
+            data.max = options.value("max").toDouble(&data.hasMax);
+            data.enumList = options.value("enum").toStringList();
+            data.value = item.value("value");
+
+            if (data.type == DataPointType::Raw && data.name != "elictricity")
+                continue;
+
+            dataPoint.append(data);
+        }
+    }
+}
 
-        switch (types.indexOf(item.value("type").toString()))
+void PropertiesTUYA::DataPoints::update(quint8 dataPoint, const QVariant &data)
+{
+    auto it = m_dataPoints.find(dataPoint);
+    QMap <QString, QVariant> map;
+
+    if (it == m_dataPoints.end())
+        return;
+
+    map = m_value.toMap();
+
+    for (int i = 0; i < it.value().count(); i++)
+    {
+        const dataPointStruct &item = it.value().at(i);
+
+        switch (item.type)
         {
-            case 0: // raw
+            case DataPointType::Raw:
             {
-                QList <QString> list = {"_TZE200_bcusnqt8", "_TZE200_lsanae15", "_TZE204_lsanae15"};
                 QByteArray payload = data.toByteArray();
                 quint16 value = 0;
 
-                if (name != "elictricity")
-                    break;
-
-                if (list.contains(manufacturerName()))
+                if (m_electricity)
                 {
                     memcpy(&value, payload.constData(), sizeof(value));
                     map.insert("voltage", qFromBigEndian(value) / 10.0);
@@ -104,56 +143,53 @@ void PropertiesTUYA::DataPoints::update(quint8 dataPoint, const QVariant &data)
                 break;
             }
 
-            case 1: // bool
+            case DataPointType::Bool:
             {
-                bool check = item.value("invert").toBool() ? !data.toBool() : data.toBool();
-                QString value = option(name).toMap().value("enum").toStringList().value(check ? 1 : 0);
+                bool check = item.invert ? !data.toBool() : data.toBool();
+                QString value = item.enumList.value(check ? 1 : 0);
 
                 if (value.isEmpty())
-                    map.insert(name, check);
+                    map.insert(item.name, check);
                 else
-                    map.insert(name, value);
+                    map.insert(item.name, value);
 
                 break;
             }
 
-            case 2: // value
+            case DataPointType::Value:
             {
-                bool hasMin, hasMax;
-                double min = options.value("min").toDouble(&hasMin), max = options.value("max").toDouble(&hasMax), value = data.toInt() / item.value("divider", 1).toDouble() / item.value("propertyDivider", 1).toDouble() + item.value("offset").toDouble();
+                double value = data.toInt() / item.divider + item.offset;
 
-                if (item.value("round").toBool())
+                if (item.round)
                     value = round(value);
 
-                if ((hasMin && value < min) || (hasMax && value > max))
+                if ((item.hasMin && value < item.min) || (item.hasMax && value > item.max))
                     break;
 
-                map.insert(name, value);
+                map.insert(item.name, value);
                 break;
             }
 
-            case 3: // enum
+            case DataPointType::Enum:
             {
-                if (options.contains("enum"))
+                if (!item.enumList.isEmpty())
                 {
-                    QString value = options.value("enum").toStringList().value(data.toInt());
+                    QString value = item.enumList.value(data.toInt());
 
                     if (!value.isEmpty())
-                        map.insert(name, value);
+                        map.insert(item.name, value);
 
                     break;
                 }
 
-                map.insert(name, data.toInt());
+                map.insert(item.name, data.toInt());
                 break;
             }
 
-            default:
+            case DataPointType::Constant:
             {
-                QVariant value = item.value("value");
-
-                if (value.isValid())
-                    map.insert(name, value);
+                if (item.value.isValid())
+                    map.insert(item.name, item.value);
 
                 break;
             }
@@ -6,6 +6,25 @@
 
 namespace PropertiesTUYA
 {
+    enum class DataPointType
+    {
+        Raw,
+        Bool,
+        Value,
+        Enum,
+        Constant
+    };
+
+    struct dataPointStruct
+    {
+        QString name;
+        DataPointType type;
+        bool invert, round, hasMin, hasMax;
+        double divider, offset, min, max;
+        QList <QString> enumList;
+        QVariant value;
+    };
+
     class Data : public PropertyObject
     {
 
@@ -26,10 +45,14 @@ namespace PropertiesTUYA
 
     public:
 
-        DataPoints(void) : Data("tuyaDataPoints") {}
+        DataPoints(void) : Data("tuyaDataPoints"), m_electricity(false) {}
+        void setup(void) override;
 
     private:
 
+        QMap <quint8, QList <dataPointStruct>> m_dataPoints;
+        bool m_electricity;
+
         void update(quint8 dataPoint, const QVariant &data) override;
 
     };
@@ -1,3 +1,4 @@
+#include <QtMath>
 #include "properties/common.h"
 #include "properties/efekta.h"
 #include "properties/ias.h"
@@ -8,101 +9,145 @@
 
 void PropertyObject::registerMetaTypes(void)
 {
-    qRegisterMetaType <Properties::BatteryVoltage>                  ("batteryVoltageProperty");
-    qRegisterMetaType <Properties::BatteryPercentage>               ("batteryPercentageProperty");
-    qRegisterMetaType <Properties::DeviceTemperature>               ("deviceTemperatureProperty");
-    qRegisterMetaType <Properties::Status>                          ("statusProperty");
-    qRegisterMetaType <Properties::PowerOnStatus>                   ("powerOnStatusProperty");
-    qRegisterMetaType <Properties::SwitchType>                      ("switchTypeProperty");
-    qRegisterMetaType <Properties::SwitchMode>                      ("switchModeProperty");
-    qRegisterMetaType <Properties::Level>                           ("levelProperty");
-    qRegisterMetaType <Properties::AnalogInput>                     ("analogInputProperty");
-    qRegisterMetaType <Properties::AnalogOutput>                    ("analogOutputProperty");
-    qRegisterMetaType <Properties::CoverPosition>                   ("coverPositionProperty");
-    qRegisterMetaType <Properties::CoverTilt>                       ("coverTiltProperty");
-    qRegisterMetaType <Properties::Thermostat>                      ("thermostatProperty");
-    qRegisterMetaType <Properties::FanMode>                         ("fanModeProperty");
-    qRegisterMetaType <Properties::DisplayMode>                     ("displayModeProperty");
-    qRegisterMetaType <Properties::ColorHS>                         ("colorHSProperty");
-    qRegisterMetaType <Properties::ColorXY>                         ("colorXYProperty");
-    qRegisterMetaType <Properties::ColorTemperature>                ("colorTemperatureProperty");
-    qRegisterMetaType <Properties::Illuminance>                     ("illuminanceProperty");
-    qRegisterMetaType <Properties::Temperature>                     ("temperatureProperty");
-    qRegisterMetaType <Properties::Pressure>                        ("pressureProperty");
-    qRegisterMetaType <Properties::Humidity>                        ("humidityProperty");
-    qRegisterMetaType <Properties::Occupancy>                       ("occupancyProperty");
-    qRegisterMetaType <Properties::OccupancyTimeout>                ("occupancyTimeoutProperty");
-    qRegisterMetaType <Properties::Moisture>                        ("moistureProperty");
-    qRegisterMetaType <Properties::CO2>                             ("co2Property");
-    qRegisterMetaType <Properties::PM25>                            ("pm25Property");
-    qRegisterMetaType <Properties::Energy>                          ("energyProperty");
-    qRegisterMetaType <Properties::Voltage>                         ("voltageProperty");
-    qRegisterMetaType <Properties::Current>                         ("currentProperty");
-    qRegisterMetaType <Properties::Power>                           ("powerProperty");
-    qRegisterMetaType <Properties::Scene>                           ("sceneProperty");
-    qRegisterMetaType <Properties::StatusAction>                    ("statusActionProperty");
-    qRegisterMetaType <Properties::LevelAction>                     ("levelActionProperty");
-    qRegisterMetaType <Properties::CoverAction>                     ("coverActionProperty");
-    qRegisterMetaType <Properties::ColorAction>                     ("colorActionProperty");
-
-    qRegisterMetaType <PropertiesIAS::Warning>                      ("iasWarningProperty");
-    qRegisterMetaType <PropertiesIAS::Contact>                      ("iasContactProperty");
-    qRegisterMetaType <PropertiesIAS::Gas>                          ("iasGasProperty");
-    qRegisterMetaType <PropertiesIAS::Occupancy>                    ("iasOccupancyProperty");
-    qRegisterMetaType <PropertiesIAS::Smoke>                        ("iasSmokeProperty");
-    qRegisterMetaType <PropertiesIAS::WaterLeak>                    ("iasWaterLeakProperty");
-
-    qRegisterMetaType <PropertiesLUMI::Data>                        ("lumiDataProperty");
-    qRegisterMetaType <PropertiesLUMI::Basic>                       ("lumiBasicProperty");
-    qRegisterMetaType <PropertiesLUMI::ButtonMode>                  ("lumiButtonModeProperty");
-    qRegisterMetaType <PropertiesLUMI::Contact>                     ("lumiContactProperty");
-    qRegisterMetaType <PropertiesLUMI::Power>                       ("lumiPowerProperty");
-    qRegisterMetaType <PropertiesLUMI::Cover>                       ("lumiCoverProperty");
-    qRegisterMetaType <PropertiesLUMI::ButtonAction>                ("lumiButtonActionProperty");
-    qRegisterMetaType <PropertiesLUMI::SwitchAction>                ("lumiSwitchActionProperty");
-    qRegisterMetaType <PropertiesLUMI::CubeRotation>                ("lumiCubeRotationProperty");
-    qRegisterMetaType <PropertiesLUMI::CubeMovement>                ("lumiCubeMovementProperty");
-    qRegisterMetaType <PropertiesLUMI::Vibration>                   ("lumiVibrationProperty");
-
-    qRegisterMetaType <PropertiesTUYA::DataPoints>                  ("tuyaDataPointsProperty");
-    qRegisterMetaType <PropertiesTUYA::HolidayThermostatProgram>    ("tuyaHolidayThermostatProgramProperty");
-    qRegisterMetaType <PropertiesTUYA::DailyThermostatProgram>      ("tuyaDailyThermostatProgramProperty");
-    qRegisterMetaType <PropertiesTUYA::MoesThermostatProgram>       ("tuyaMoesThermostatProgramProperty");
-    qRegisterMetaType <PropertiesTUYA::CoverMotor>                  ("tuyaCoverMotorProperty");
-    qRegisterMetaType <PropertiesTUYA::CoverSwitch>                 ("tuyaCoverSwitchProperty");
-    qRegisterMetaType <PropertiesTUYA::ChildLock>                   ("tuyaChildLockProperty");
-    qRegisterMetaType <PropertiesTUYA::OperationMode>               ("tuyaOperationModeProperty");
-    qRegisterMetaType <PropertiesTUYA::IndicatorMode>               ("tuyaIndicatorModeProperty");
-    qRegisterMetaType <PropertiesTUYA::SwitchType>                  ("tuyaSwitchTypeProperty");
-    qRegisterMetaType <PropertiesTUYA::PowerOnStatus>               ("tuyaPowerOnStatusProperty");
-    qRegisterMetaType <PropertiesTUYA::ButtonAction>                ("tuyaButtonActionProperty");
-
-    qRegisterMetaType <PropertiesEfekta::ReportingDelay>            ("efektaReportingDelayProperty");
-    qRegisterMetaType <PropertiesEfekta::TemperatureSettings>       ("efektaTemperatureSettingsProperty");
-    qRegisterMetaType <PropertiesEfekta::HumiditySettings>          ("efektaHumiditySettingsProperty");
-    qRegisterMetaType <PropertiesEfekta::CO2Settings>               ("efektaCO2SettingsProperty");
-    qRegisterMetaType <PropertiesEfekta::PMSensor>                  ("efektaPMSensorProperty");
-    qRegisterMetaType <PropertiesEfekta::VOCSensor>                 ("efektaVOCSensorProperty");
-
-    qRegisterMetaType <PropertiesPTVO::ChangePattern>               ("ptvoChangePatternProperty");
-    qRegisterMetaType <PropertiesPTVO::Contact>                     ("ptvoContactProperty");
-    qRegisterMetaType <PropertiesPTVO::Occupancy>                   ("ptvoOccupancyProperty");
-    qRegisterMetaType <PropertiesPTVO::WaterLeak>                   ("ptvoWaterLeakProperty");
-    qRegisterMetaType <PropertiesPTVO::CO2>                         ("ptvoCO2Property");
-    qRegisterMetaType <PropertiesPTVO::Temperature>                 ("ptvoTemperatureProperty");
-    qRegisterMetaType <PropertiesPTVO::Humidity>                    ("ptvoHumidityProperty");
-    qRegisterMetaType <PropertiesPTVO::Count>                       ("ptvoCountProperty");
-    qRegisterMetaType <PropertiesPTVO::Pattern>                     ("ptvoPatternProperty");
-    qRegisterMetaType <PropertiesPTVO::ButtonAction>                ("ptvoButtonActionProperty");
-    qRegisterMetaType <PropertiesPTVO::SwitchAction>                ("ptvoSwitchActionProperty");
-    qRegisterMetaType <PropertiesPTVO::SerialData>                  ("ptvoSerialDataProperty");
-
-    qRegisterMetaType <PropertiesByun::GasSensor>                   ("byunGasSensorProperty");
-    qRegisterMetaType <PropertiesByun::SmokeSensor>                 ("byunSmokeSensorProperty");
-
-    qRegisterMetaType <PropertiesIKEA::Occupancy>                   ("ikeaOccupancyProperty");
-    qRegisterMetaType <PropertiesIKEA::StatusAction>                ("ikeaStatusActionProperty");
-    qRegisterMetaType <PropertiesIKEA::ArrowAction>                 ("ikeaArrowActionProperty");
+    Registry <PropertyObject>::add <Properties::BatteryVoltage>               ("batteryVoltage");
+    Registry <PropertyObject>::add <Properties::BatteryPercentage>            ("batteryPercentage");
+    Registry <PropertyObject>::add <Properties::DeviceTemperature>            ("deviceTemperature");
+    Registry <PropertyObject>::add <Properties::Status>                       ("status");
+    Registry <PropertyObject>::add <Properties::PowerOnStatus>                ("powerOnStatus");
+    Registry <PropertyObject>::add <Properties::SwitchType>                   ("switchType");
+    Registry <PropertyObject>::add <Properties::SwitchMode>                   ("switchMode");
+    Registry <PropertyObject>::add <Properties::Level>                        ("level");
+    Registry <PropertyObject>::add <Properties::AnalogInput>                  ("analogInput");
+    Registry <PropertyObject>::add <Properties::AnalogOutput>                 ("analogOutput");
+    Registry <PropertyObject>::add <Properties::CoverPosition>                ("coverPosition");
+    Registry <PropertyObject>::add <Properties::CoverTilt>                    ("coverTilt");
+    Registry <PropertyObject>::add <Properties::Thermostat>                   ("thermostat");
+    Registry <PropertyObject>::add <Properties::FanMode>                      ("fanMode");
+    Registry <PropertyObject>::add <Properties::DisplayMode>                  ("displayMode");
+    Registry <PropertyObject>::add <Properties::ColorHS>                      ("colorHS");
+    Registry <PropertyObject>::add <Properties::ColorXY>                      ("colorXY");
+    Registry <PropertyObject>::add <Properties::ColorTemperature>             ("colorTemperature");
+    Registry <PropertyObject>::add <Properties::Illuminance>                  ("illuminance");
+    Registry <PropertyObject>::add <Properties::Temperature>                  ("temperature");
+    Registry <PropertyObject>::add <Properties::Pressure>                     ("pressure");
+    Registry <PropertyObject>::add <Properties::Humidity>                     ("humidity");
+    Registry <PropertyObject>::add <Properties::Occupancy>                    ("occupancy");
+    Registry <PropertyObject>::add <Properties::OccupancyTimeout>             ("occupancyTimeout");
+    Registry <PropertyObject>::add <Properties::Moisture>                     ("moisture");
+    Registry <PropertyObject>::add <Properties::CO2>                          ("co2");
+    Registry <PropertyObject>::add <Properties::PM25>                         ("pm25");
+    Registry <PropertyObject>::add <Properties::Energy>                       ("energy");
+    Registry <PropertyObject>::add <Properties::Voltage>                      ("voltage");
+    Registry <PropertyObject>::add <Properties::Current>                      ("current");
+    Registry <PropertyObject>::add <Properties::Power>                        ("power");
+    Registry <PropertyObject>::add <Properties::Scene>                        ("scene");
+    Registry <PropertyObject>::add <Properties::StatusAction>                 ("statusAction");
+    Registry <PropertyObject>::add <Properties::LevelAction>                  ("levelAction");
+    Registry <PropertyObject>::add <Properties::CoverAction>                  ("coverAction");
+    Registry <PropertyObject>::add <Properties::ColorAction>                  ("colorAction");
+
+    Registry <PropertyObject>::add <PropertiesIAS::Warning>                   ("iasWarning");
+    Registry <PropertyObject>::add <PropertiesIAS::Contact>                   ("iasContact");
+    Registry <PropertyObject>::add <PropertiesIAS::Gas>                       ("iasGas");
+    Registry <PropertyObject>::add <PropertiesIAS::Occupancy>                 ("iasOccupancy");
+    Registry <PropertyObject>::add <PropertiesIAS::Smoke>                     ("iasSmoke");
+    Registry <PropertyObject>::add <PropertiesIAS::WaterLeak>                 ("iasWaterLeak");
+
+    Registry <PropertyObject>::add <PropertiesLUMI::Data>                     ("lumiData");
+    Registry <PropertyObject>::add <PropertiesLUMI::Basic>                    ("lumiBasic");
+    Registry <PropertyObject>::add <PropertiesLUMI::ButtonMode>               ("lumiButtonMode");
+    Registry <PropertyObject>::add <PropertiesLUMI::Contact>                  ("lumiContact");
+    Registry <PropertyObject>::add <PropertiesLUMI::Power>                    ("lumiPower");
+    Registry <PropertyObject>::add <PropertiesLUMI::Cover>                    ("lumiCover");
+    Registry <PropertyObject>::add <PropertiesLUMI::ButtonAction>             ("lumiButtonAction");
+    Registry <PropertyObject>::add <PropertiesLUMI::SwitchAction>             ("lumiSwitchAction");
+    Registry <PropertyObject>::add <PropertiesLUMI::CubeRotation>             ("lumiCubeRotation");
+    Registry <PropertyObject>::add <PropertiesLUMI::CubeMovement>             ("lumiCubeMovement");
+    Registry <PropertyObject>::add <PropertiesLUMI::Vibration>                ("lumiVibration");
+
+    Registry <PropertyObject>::add <PropertiesTUYA::DataPoints>               ("tuyaDataPoints");
+    Registry <PropertyObject>::add <PropertiesTUYA::HolidayThermostatProgram> ("tuyaHolidayThermostatProgram");
+    Registry <PropertyObject>::add <PropertiesTUYA::DailyThermostatProgram>   ("tuyaDailyThermostatProgram");
+    Registry <PropertyObject>::add <PropertiesTUYA::MoesThermostatProgram>    ("tuyaMoesThermostatProgram");
+    Registry <PropertyObject>::add <PropertiesTUYA::CoverMotor>               ("tuyaCoverMotor");
+    Registry <PropertyObject>::add <PropertiesTUYA::CoverSwitch>              ("tuyaCoverSwitch");
+    Registry <PropertyObject>::add <PropertiesTUYA::ChildLock>                ("tuyaChildLock");
+    Registry <PropertyObject>::add <PropertiesTUYA::OperationMode>            ("tuyaOperationMode");
+    Registry <PropertyObject>::add <PropertiesTUYA::IndicatorMode>            ("tuyaIndicatorMode");
+    Registry <PropertyObject>::add <PropertiesTUYA::SwitchType>               ("tuyaSwitchType");
+    Registry <PropertyObject>::add <PropertiesTUYA::PowerOnStatus>            ("tuyaPowerOnStatus");
+    Registry <PropertyObject>::add <PropertiesTUYA::ButtonAction>             ("tuyaButtonAction");
+
+    Registry <PropertyObject>::add <PropertiesEfekta::ReportingDelay>         ("efektaReportingDelay");
+    Registry <PropertyObject>::add <PropertiesEfekta::TemperatureSettings>    ("efektaTemperatureSettings");
+    Registry <PropertyObject>::add <PropertiesEfekta::HumiditySettings>       ("efektaHumiditySettings");
+    Registry <PropertyObject>::add <PropertiesEfekta::CO2Settings>            ("efektaCO2Settings");
+    Registry <PropertyObject>::add <PropertiesEfekta::PMSensor>               ("efektaPMSensor");
+    Registry <PropertyObject>::add <PropertiesEfekta::VOCSensor>              ("efektaVOCSensor");
+
+    Registry <PropertyObject>::add <PropertiesPTVO::ChangePattern>            ("ptvoChangePattern");
+    Registry <PropertyObject>::add <PropertiesPTVO::Contact>                  ("ptvoContact");
+    Registry <PropertyObject>::add <PropertiesPTVO::Occupancy>                ("ptvoOccupancy");
+    Registry <PropertyObject>::add <PropertiesPTVO::WaterLeak>                ("ptvoWaterLeak");
+    Registry <PropertyObject>::add <PropertiesPTVO::CO2>                      ("ptvoCO2");
+    Registry <PropertyObject>::add <PropertiesPTVO::Temperature>              ("ptvoTemperature");
+    Registry <PropertyObject>::add <PropertiesPTVO::Humidity>                 ("ptvoHumidity");
+    Registry <PropertyObject>::add <PropertiesPTVO::Count>                    ("ptvoCount");
+    Registry <PropertyObject>::add <PropertiesPTVO::Pattern>                  ("ptvoPattern");
+    Registry <PropertyObject>::add <PropertiesPTVO::ButtonAction>             ("ptvoButtonAction");
+    Registry <PropertyObject>::add <PropertiesPTVO::SwitchAction>             ("ptvoSwitchAction");
+    Registry <PropertyObject>::add <PropertiesPTVO::SerialData>               ("ptvoSerialData");
+
+    Registry <PropertyObject>::add <PropertiesByun::GasSensor>                ("byunGasSensor");
+    Registry <PropertyObject>::add <PropertiesByun::SmokeSensor>              ("byunSmokeSensor");
+
+    Registry <PropertyObject>::add <PropertiesIKEA::Occupancy>                ("ikeaOccupancy");
+    Registry <PropertyObject>::add <PropertiesIKEA::StatusAction>             ("ikeaStatusAction");
+    Registry <PropertyObject>::add <PropertiesIKEA::ArrowAction>              ("ikeaArrowAction");
+}
+
+bool PropertyObject::filterValue(const QVariant &previous)
+{
+    QMap <QString, QVariant> map, last;
+
+    if (m_filters.isEmpty())
+        return true;
+
+    if (m_value.type() != QVariant::Map)
+        return filterItem(m_name, m_value, previous);
+
+    map = m_value.toMap();
+    last = previous.toMap();
+
+    for (auto it = map.begin(); it != map.end(); it++)
+        filterItem(it.key(), it.value(), last.value(it.key()));
+
+    m_value = map;
+    return true;
+}
+
+bool PropertyObject::filterItem(const QString &name, QVariant &value, const QVariant &previous)
+{
+    auto it = m_filters.constFind(name);
+    double number;
+
+    if (it == m_filters.constEnd() || (value.type() != QVariant::Double && value.type() != QVariant::Int && value.type() != QVariant::UInt && value.type() != QVariant::LongLong && value.type() != QVariant::ULongLong))
+        return true;
+
+    number = value.toDouble();
+
+    if (it.value().round >= 0 && value.type() == QVariant::Double)
+    {
+        double factor = pow(10, it.value().round);
+        number = round(number * factor) / factor;
+        value = number;
+    }
+
+    if (!it.value().deadband || !previous.isValid() || fabs(number - previous.toDouble()) >= (it.value().percent ? fabs(previous.toDouble()) * it.value().deadband / 100 : it.value().deadband))
+        return true;
+
+    value = previous;
+    return false;
 }
 
 quint8 PropertyObject::percentage(double min, double max, double value)
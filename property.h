@@ -4,6 +4,14 @@
 #include <QSharedPointer>
 #include <QVariant>
 #include "endpoint.h"
+#include "registry.h"
+
+struct valueFilterStruct
+{
+    double deadband;
+    bool percent;
+    int round;
+};
 
 class PropertyObject;
 typedef QSharedPointer <PropertyObject> Property;
@@ -23,6 +31,7 @@ public:
     virtual void parseAttribte(quint16, quint16, const QByteArray &) {}
     virtual void parseCommand(quint16, quint8, const QByteArray &) {}
     virtual void resetValue(void) {}
+    virtual void setup(void) {}
 
     inline QList <quint16> &clusters(void) { return m_clusters; }
 
@@ -42,6 +51,10 @@ public:
     inline void setValue(const QVariant &value) { m_value = value; }
     inline void clearValue(void) { m_value = QVariant(); }
 
+    inline void setFilters(const QMap <QString, valueFilterStruct> &value) { m_filters = value; }
+
+    bool filterValue(const QVariant &previous);
+
     static void registerMetaTypes(void);
 
 protected:
@@ -55,6 +68,10 @@ protected:
     quint8 m_transactionId;
     QVariant m_value;
 
+    QMap <QString, valueFilterStruct> m_filters;
+
+    bool filterItem(const QString &name, QVariant &value, const QVariant &previous);
+
     quint8 percentage(double min, double max, double value);
     QVariant enumValue(const QString &name, int index);
 
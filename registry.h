@@ -0,0 +1,35 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include <QHash>
+#include <QString>
+
+template <class T>
+class Registry
+{
+
+public:
+
+    template <class C>
+    static void add(const QString &name) { m_factories.insert(name, &factory <C>); }
+
+    static T *create(const QString &name)
+    {
+        auto it = m_factories.constFind(name);
+        return it != m_factories.constEnd() ? it.value()() : nullptr;
+    }
+
+private:
+
+    typedef T *(*Factory)(void);
+    static QHash <QString, Factory> m_factories;
+
+    template <class C>
+    static T *factory(void) { return new C; }
+
+};
+
+template <class T>
+QHash <QString, typename Registry <T>::Factory> Registry <T>::m_factories;
+
+#endif
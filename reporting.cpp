@@ -2,39 +2,39 @@
 
 void ReportingObject::registerMetaTypes(void)
 {
-    qRegisterMetaType <Reportings::BatteryVoltage>          ("batteryVoltageReporting");
-    qRegisterMetaType <Reportings::BatteryPercentage>       ("batteryPercentageReporting");
-    qRegisterMetaType <Reportings::DeviceTemperature>       ("deviceTemperatureReporting");
-    qRegisterMetaType <Reportings::Status>                  ("statusReporting");
-    qRegisterMetaType <Reportings::Level>                   ("levelReporting");
-    qRegisterMetaType <Reportings::AnalogInput>             ("analogInputReporting");
-    qRegisterMetaType <Reportings::AnalogOutput>            ("analogOutputReporting");
-    qRegisterMetaType <Reportings::CoverPosition>           ("coverPositionReporting");
-    qRegisterMetaType <Reportings::CoverTilt>               ("coverTiltReporting");
-    qRegisterMetaType <Reportings::Thermostat>              ("thermostatReporting");
-    qRegisterMetaType <Reportings::ColorHS>                 ("colorHSReporting");
-    qRegisterMetaType <Reportings::ColorXY>                 ("colorXYReporting");
-    qRegisterMetaType <Reportings::ColorTemperature>        ("colorTemperatureReporting");
-    qRegisterMetaType <Reportings::Illuminance>             ("illuminanceReporting");
-    qRegisterMetaType <Reportings::Temperature>             ("temperatureReporting");
-    qRegisterMetaType <Reportings::Pressure>                ("pressureReporting");
-    qRegisterMetaType <Reportings::Humidity>                ("humidityReporting");
-    qRegisterMetaType <Reportings::Occupancy>               ("occupancyReporting");
-    qRegisterMetaType <Reportings::Moisture>                ("moistureReporting");
-    qRegisterMetaType <Reportings::CO2>                     ("co2Reporting");
-    qRegisterMetaType <Reportings::PM25>                    ("pm25Reporting");
-    qRegisterMetaType <Reportings::Energy>                  ("energyReporting");
-    qRegisterMetaType <Reportings::Voltage>                 ("voltageReporting");
-    qRegisterMetaType <Reportings::Current>                 ("currentReporting");
-    qRegisterMetaType <Reportings::Power>                   ("powerReporting");
+    Registry <ReportingObject>::add <Reportings::BatteryVoltage>        ("batteryVoltage");
+    Registry <ReportingObject>::add <Reportings::BatteryPercentage>     ("batteryPercentage");
+    Registry <ReportingObject>::add <Reportings::DeviceTemperature>     ("deviceTemperature");
+    Registry <ReportingObject>::add <Reportings::Status>                ("status");
+    Registry <ReportingObject>::add <Reportings::Level>                 ("level");
+    Registry <ReportingObject>::add <Reportings::AnalogInput>           ("analogInput");
+    Registry <ReportingObject>::add <Reportings::AnalogOutput>          ("analogOutput");
+    Registry <ReportingObject>::add <Reportings::CoverPosition>         ("coverPosition");
+    Registry <ReportingObject>::add <Reportings::CoverTilt>             ("coverTilt");
+    Registry <ReportingObject>::add <Reportings::Thermostat>            ("thermostat");
+    Registry <ReportingObject>::add <Reportings::ColorHS>               ("colorHS");
+    Registry <ReportingObject>::add <Reportings::ColorXY>               ("colorXY");
+    Registry <ReportingObject>::add <Reportings::ColorTemperature>      ("colorTemperature");
+    Registry <ReportingObject>::add <Reportings::Illuminance>           ("illuminance");
+    Registry <ReportingObject>::add <Reportings::Temperature>           ("temperature");
+    Registry <ReportingObject>::add <Reportings::Pressure>              ("pressure");
+    Registry <ReportingObject>::add <Reportings::Humidity>              ("humidity");
+    Registry <ReportingObject>::add <Reportings::Occupancy>             ("occupancy");
+    Registry <ReportingObject>::add <Reportings::Moisture>              ("moisture");
+    Registry <ReportingObject>::add <Reportings::CO2>                   ("co2");
+    Registry <ReportingObject>::add <Reportings::PM25>                  ("pm25");
+    Registry <ReportingObject>::add <Reportings::Energy>                ("energy");
+    Registry <ReportingObject>::add <Reportings::Voltage>               ("voltage");
+    Registry <ReportingObject>::add <Reportings::Current>               ("current");
+    Registry <ReportingObject>::add <Reportings::Power>                 ("power");
 
-    qRegisterMetaType <ReportingsEfekta::PMSensor>          ("efektaPMSensorReporting");
-    qRegisterMetaType <ReportingsEfekta::VOCSensor>         ("efektaVOCSensorReporting");
+    Registry <ReportingObject>::add <ReportingsEfekta::PMSensor>        ("efektaPMSensor");
+    Registry <ReportingObject>::add <ReportingsEfekta::VOCSensor>       ("efektaVOCSensor");
 
-    qRegisterMetaType <ReportingsModkam::EventsPerMinute>   ("modkamEventsPerMinuteReporting");
-    qRegisterMetaType <ReportingsModkam::DosePerHour>       ("modkamDosePerHourReporting");
+    Registry <ReportingObject>::add <ReportingsModkam::EventsPerMinute> ("modkamEventsPerMinute");
+    Registry <ReportingObject>::add <ReportingsModkam::DosePerHour>     ("modkamDosePerHour");
 
-    qRegisterMetaType <ReportingsPerenio::Voltage>          ("perenioVoltageReporting");
-    qRegisterMetaType <ReportingsPerenio::Power>            ("perenioPowerReporting");
-    qRegisterMetaType <ReportingsPerenio::Energy>           ("perenioEnergyReporting");
+    Registry <ReportingObject>::add <ReportingsPerenio::Voltage>        ("perenioVoltage");
+    Registry <ReportingObject>::add <ReportingsPerenio::Power>          ("perenioPower");
+    Registry <ReportingObject>::add <ReportingsPerenio::Energy>         ("perenioEnergy");
 }
@@ -2,6 +2,7 @@
 #define REPORTING_H
 
 #include <QSharedPointer>
+#include "registry.h"
 #include "zcl.h"
 
 class ReportingObject;
@@ -0,0 +1,37 @@
+include(../../../homed-common/homed-color.pri)
+include(../../../homed-common/homed-common.pri)
+include(../../../homed-common/homed-endpoint.pri)
+
+QT += testlib
+QT -= gui
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_lumi
+INCLUDEPATH += ../..
+SOURCES -= $$find(SOURCES, main\\.cpp$)
+
+HEADERS += \
+    ../../properties/common.h \
+    ../../properties/efekta.h \
+    ../../properties/ias.h \
+    ../../properties/lumi.h \
+    ../../properties/other.h \
+    ../../properties/ptvo.h \
+    ../../properties/tuya.h \
+    ../../property.h \
+    ../../registry.h \
+    ../../zcl.h
+
+SOURCES += \
+    ../../properties/common.cpp \
+    ../../properties/efekta.cpp \
+    ../../properties/ias.cpp \
+    ../../properties/lumi.cpp \
+    ../../properties/other.cpp \
+    ../../properties/ptvo.cpp \
+    ../../properties/tuya.cpp \
+    ../../property.cpp \
+    ../../zcl.cpp \
+    tst_lumi.cpp
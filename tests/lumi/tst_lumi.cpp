@@ -0,0 +1,131 @@
+#include <QtTest>
+#include "properties/lumi.h"
+
+class TestLumi : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void heartbeat(void);
+    void heartbeatUpdate(void);
+    void heartbeatLong(void);
+    void heartbeatTruncated(void);
+    void restoredValue(void);
+
+    void benchmarkHeartbeat(void);
+
+private:
+
+    QByteArray heartbeatData(quint16 voltage, quint16 outageCount);
+
+};
+
+QByteArray TestLumi::heartbeatData(quint16 voltage, quint16 outageCount)
+{
+    // lumi.weather 0xFF01 report with battery voltage, outage count and a few records the parser skips
+
+    QByteArray data = QByteArray::fromHex("0121e50b" "0421a813" "05212c00" "06240100000000" "0a210000");
+
+    data[2] = static_cast <char> (voltage & 0xFF);
+    data[3] = static_cast <char> (voltage >> 8);
+    data[10] = static_cast <char> (outageCount & 0xFF);
+    data[11] = static_cast <char> (outageCount >> 8);
+
+    return data;
+}
+
+void TestLumi::heartbeat(void)
+{
+    PropertiesLUMI::Data property;
+    QMap <QString, QVariant> map;
+
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, heartbeatData(2925, 44));
+    map = property.value().toMap();
+
+    QCOMPARE(map.count(), 2);
+    QCOMPARE(map.value("battery").toInt(), 50);
+    QCOMPARE(map.value("outageCount").toInt(), 43);
+}
+
+void TestLumi::heartbeatUpdate(void)
+{
+    PropertiesLUMI::Data property;
+    QMap <QString, QVariant> map;
+
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, heartbeatData(3045, 44));
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, heartbeatData(2880, 44));
+    map = property.value().toMap();
+
+    QCOMPARE(map.value("battery").toInt(), 20);
+    QCOMPARE(map.value("outageCount").toInt(), 43);
+}
+
+void TestLumi::heartbeatLong(void)
+{
+    PropertiesLUMI::Data property;
+    QByteArray data;
+    QMap <QString, QVariant> map;
+
+    for (int i = 0; i < 70; i++)
+        data.append(QByteArray::fromHex("0a210000"));
+
+    data.append(heartbeatData(2861, 3));
+    QVERIFY(data.length() > 255);
+
+    property.parseAttribte(CLUSTER_LUMI, 0x00F7, data);
+    map = property.value().toMap();
+
+    QCOMPARE(map.value("battery").toInt(), 7);
+    QCOMPARE(map.value("outageCount").toInt(), 2);
+}
+
+void TestLumi::heartbeatTruncated(void)
+{
+    PropertiesLUMI::Data property;
+    QMap <QString, QVariant> map;
+
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, QByteArray::fromHex("0121e5"));
+    QVERIFY(!property.value().isValid());
+
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, QByteArray::fromHex("0121e50b0542"));
+    map = property.value().toMap();
+
+    QCOMPARE(map.count(), 1);
+    QCOMPARE(map.value("battery").toInt(), 100);
+}
+
+void TestLumi::restoredValue(void)
+{
+    PropertiesLUMI::Data property;
+    QMap <QString, QVariant> map;
+
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, heartbeatData(2925, 44));
+    property.setValue(QMap <QString, QVariant> {{"outageCount", 5}, {"switchMode", "decoupled"}});
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, QByteArray::fromHex("0121e50b"));
+    map = property.value().toMap();
+
+    QCOMPARE(map.count(), 3);
+    QCOMPARE(map.value("battery").toInt(), 100);
+    QCOMPARE(map.value("outageCount").toInt(), 5);
+    QCOMPARE(map.value("switchMode").toString(), QString("decoupled"));
+
+    property.clearValue();
+    property.parseAttribte(CLUSTER_BASIC, 0xFF01, QByteArray::fromHex("0121e50b"));
+    QCOMPARE(property.value().toMap().count(), 1);
+}
+
+void TestLumi::benchmarkHeartbeat(void)
+{
+    PropertiesLUMI::Data property;
+    QByteArray data = heartbeatData(2925, 44);
+
+    QBENCHMARK
+    {
+        property.parseAttribte(CLUSTER_BASIC, 0xFF01, data);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestLumi)
+
+#include "tst_lumi.moc"
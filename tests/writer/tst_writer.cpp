@@ -0,0 +1,99 @@
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtTest>
+#include "writer.h"
+
+class TestWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void values(void);
+    void strings(void);
+    void nested(void);
+    void document(void);
+    void buffer(void);
+
+    void benchmarkWriter(void);
+    void benchmarkDocument(void);
+
+private:
+
+    QMap <QString, QVariant> payload(void);
+
+};
+
+QMap <QString, QVariant> TestWriter::payload(void)
+{
+    return {{"linkQuality", 112}, {"battery", 87}, {"temperature", 21.37}, {"humidity", 48.2}, {"pressure", 101.3}, {"occupancy", true}, {"voltage", 229.4}, {"current", 0.42}, {"power", 96.35}, {"energy", Q_UINT64_C(123456)}, {"status", "on"}, {"colorMode", "xy"}};
+}
+
+void TestWriter::values(void)
+{
+    JsonWriter writer;
+
+    QCOMPARE(writer.write({{"a", true}, {"b", false}, {"c", QVariant()}}), QByteArray("{\"a\":true,\"b\":false,\"c\":null}"));
+    QCOMPARE(writer.write({{"a", -128}, {"b", Q_INT64_C(-9007199254740993)}, {"c", Q_UINT64_C(4294967296)}}), QByteArray("{\"a\":-128,\"b\":-9007199254740993,\"c\":4294967296}"));
+    QCOMPARE(writer.write({{"a", 0.5}, {"b", 21.0}, {"c", qInf()}, {"d", qQNaN()}}), QByteArray("{\"a\":0.5,\"b\":21,\"c\":null,\"d\":null}"));
+    QCOMPARE(writer.write({}), QByteArray("{}"));
+}
+
+void TestWriter::strings(void)
+{
+    JsonWriter writer;
+
+    QCOMPARE(writer.write({{"a", "quote\" slash\\ tab\t nl\n"}}), QByteArray("{\"a\":\"quote\\\" slash\\\\ tab\\t nl\\n\"}"));
+    QCOMPARE(writer.write({{"a", QString(QChar(0x01))}}), QByteArray("{\"a\":\"\\u0001\"}"));
+    QCOMPARE(writer.write({{"a", QString::fromUtf8("\xd0\x9a\xd1\x83\xd1\x85\xd0\xbd\xd1\x8f \xe2\x82\xac \xf0\x9f\x92\xa1")}}), QByteArray("{\"a\":\"\xd0\x9a\xd1\x83\xd1\x85\xd0\xbd\xd1\x8f \xe2\x82\xac \xf0\x9f\x92\xa1\"}"));
+}
+
+void TestWriter::nested(void)
+{
+    JsonWriter writer;
+    QMap <QString, QVariant> map = {{"color", QMap <QString, QVariant> {{"x", 0.3}, {"y", 0.4}}}, {"list", QList <QVariant> {1, "two", false}}};
+
+    QCOMPARE(writer.write(map), QByteArray("{\"color\":{\"x\":0.3,\"y\":0.4},\"list\":[1,\"two\",false]}"));
+}
+
+void TestWriter::document(void)
+{
+    JsonWriter writer;
+    QMap <QString, QVariant> map = payload();
+
+    QCOMPARE(writer.write(map), QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact));
+}
+
+void TestWriter::buffer(void)
+{
+    JsonWriter writer;
+    const char *data = writer.write(payload()).constData();
+
+    QVERIFY(writer.write(payload()).constData() == data);
+    QCOMPARE(writer.write({{"a", 1}}), QByteArray("{\"a\":1}"));
+}
+
+void TestWriter::benchmarkWriter(void)
+{
+    JsonWriter writer;
+    QMap <QString, QVariant> map = payload();
+
+    QBENCHMARK
+    {
+        writer.write(map);
+    }
+}
+
+void TestWriter::benchmarkDocument(void)
+{
+    QMap <QString, QVariant> map = payload();
+
+    QBENCHMARK
+    {
+        QJsonDocument(QJsonObject::fromVariantMap(map)).toJson(QJsonDocument::Compact);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestWriter)
+
+#include "tst_writer.moc"
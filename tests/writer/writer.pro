@@ -0,0 +1,15 @@
+QT += testlib
+QT -= gui
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_writer
+INCLUDEPATH += ../..
+
+HEADERS += \
+    ../../writer.h
+
+SOURCES += \
+    ../../writer.cpp \
+    tst_writer.cpp
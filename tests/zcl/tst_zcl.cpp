@@ -0,0 +1,242 @@
+#include <QtMath>
+#include <QtTest>
+#include "zcl.h"
+
+class TestZcl : public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void frameHeader(void);
+    void frameManufacturerSpecific(void);
+    void frameTooShort(void);
+    void payloadStruct(void);
+
+    void readAttribute(void);
+    void readAttributeStatus(void);
+    void readAttributeTruncated(void);
+
+    void decodeInteger(void);
+    void decodeSigned(void);
+    void decodeFloat(void);
+    void decodeInvalid(void);
+    void decodeShort(void);
+
+    void valueWidening(void);
+    void dataSizeCursor(void);
+
+};
+
+void TestZcl::frameHeader(void)
+{
+    ZclFrame frame(QByteArray::fromHex("182a0a0000213412"));
+
+    QVERIFY(frame.valid());
+    QCOMPARE(frame.frameControl(), static_cast <quint8> (0x18));
+    QCOMPARE(frame.manufacturerCode(), static_cast <quint16> (0x0000));
+    QCOMPARE(frame.transactionId(), static_cast <quint8> (0x2A));
+    QCOMPARE(frame.commandId(), static_cast <quint8> (CMD_REPORT_ATTRIBUTES));
+    QCOMPARE(frame.length(), 5);
+    QCOMPARE(frame.payload(), QByteArray::fromHex("0000213412"));
+    QCOMPARE(frame.payload(3), QByteArray::fromHex("3412"));
+    QVERIFY(frame.payload(5).isEmpty());
+}
+
+void TestZcl::frameManufacturerSpecific(void)
+{
+    ZclFrame frame(QByteArray::fromHex("1c5f11070af70041"));
+
+    QVERIFY(frame.valid());
+    QCOMPARE(frame.manufacturerCode(), static_cast <quint16> (MANUFACTURER_CODE_LUMI));
+    QCOMPARE(frame.transactionId(), static_cast <quint8> (0x07));
+    QCOMPARE(frame.commandId(), static_cast <quint8> (CMD_REPORT_ATTRIBUTES));
+    QCOMPARE(frame.payload(), QByteArray::fromHex("f70041"));
+}
+
+void TestZcl::frameTooShort(void)
+{
+    QVERIFY(!ZclFrame(QByteArray()).valid());
+    QVERIFY(!ZclFrame(QByteArray::fromHex("1801")).valid());
+    QVERIFY(!ZclFrame(QByteArray::fromHex("1c5f1107")).valid());
+    QVERIFY(ZclFrame(QByteArray::fromHex("18010b")).valid());
+    QCOMPARE(ZclFrame(QByteArray::fromHex("18010b")).length(), 0);
+}
+
+void TestZcl::payloadStruct(void)
+{
+    ZclFrame frame(QByteArray::fromHex("09010b0a00"));
+    const defaultResponseStruct *response = frame.payload <defaultResponseStruct> ();
+
+    QVERIFY(response);
+    QCOMPARE(response->commandId, static_cast <quint8> (0x0A));
+    QCOMPARE(response->status, static_cast <quint8> (STATUS_SUCCESS));
+    QVERIFY(!frame.payload <defaultResponseStruct> (1));
+    QVERIFY(!frame.payload <defaultResponseStruct> (-1));
+}
+
+void TestZcl::readAttribute(void)
+{
+    ZclFrame frame(QByteArray::fromHex("18010a00002134120500420348656c"));
+    quint16 attributeId;
+    quint8 dataType;
+    QByteArray data;
+    int offset = 0;
+
+    QVERIFY(frame.readAttribute(offset, attributeId, dataType, data, false));
+    QCOMPARE(attributeId, static_cast <quint16> (0x0000));
+    QCOMPARE(dataType, static_cast <quint8> (DATA_TYPE_16BIT_UNSIGNED));
+    QCOMPARE(data, QByteArray::fromHex("3412"));
+    QCOMPARE(offset, 5);
+
+    QVERIFY(frame.readAttribute(offset, attributeId, dataType, data, false));
+    QCOMPARE(attributeId, static_cast <quint16> (0x0005));
+    QCOMPARE(dataType, static_cast <quint8> (DATA_TYPE_CHARACTER_STRING));
+    QCOMPARE(data, QByteArray("Hel"));
+    QCOMPARE(offset, frame.length());
+
+    QVERIFY(!frame.readAttribute(offset, attributeId, dataType, data, false));
+}
+
+void TestZcl::readAttributeStatus(void)
+{
+    ZclFrame frame(QByteArray::fromHex("1801010000002005010086"));
+    quint16 attributeId;
+    quint8 dataType;
+    QByteArray data;
+    int offset = 0;
+
+    QVERIFY(frame.readAttribute(offset, attributeId, dataType, data, true));
+    QCOMPARE(attributeId, static_cast <quint16> (0x0000));
+    QCOMPARE(dataType, static_cast <quint8> (DATA_TYPE_8BIT_UNSIGNED));
+    QCOMPARE(data, QByteArray::fromHex("05"));
+
+    QVERIFY(frame.readAttribute(offset, attributeId, dataType, data, true));
+    QCOMPARE(attributeId, static_cast <quint16> (0x0001));
+    QCOMPARE(dataType, static_cast <quint8> (DATA_TYPE_NO_DATA));
+    QVERIFY(data.isEmpty());
+    QCOMPARE(offset, frame.length());
+}
+
+void TestZcl::readAttributeTruncated(void)
+{
+    quint16 attributeId;
+    quint8 dataType;
+    QByteArray data;
+    int offset = 0;
+
+    QVERIFY(!ZclFrame(QByteArray::fromHex("18010a00002134")).readAttribute(offset, attributeId, dataType, data, false));
+    QVERIFY(!ZclFrame(QByteArray::fromHex("18010a000042054865")).readAttribute(offset, attributeId, dataType, data, false));
+    QVERIFY(!ZclFrame(QByteArray::fromHex("18010a000042")).readAttribute(offset, attributeId, dataType, data, false));
+    QVERIFY(!ZclFrame(QByteArray::fromHex("18010a0000ff00")).readAttribute(offset, attributeId, dataType, data, false));
+
+    offset = -1;
+    QVERIFY(!ZclFrame(QByteArray::fromHex("18010a0000213412")).readAttribute(offset, attributeId, dataType, data, false));
+}
+
+void TestZcl::decodeInteger(void)
+{
+    QCOMPARE(zclDecode(DATA_TYPE_BOOLEAN, QByteArray::fromHex("01")).toBool(), true);
+    QCOMPARE(zclDecode(DATA_TYPE_8BIT_UNSIGNED, QByteArray::fromHex("ff")).toULongLong(), Q_UINT64_C(0xFF));
+    QCOMPARE(zclDecode(DATA_TYPE_24BIT_UNSIGNED, QByteArray::fromHex("010203")).toULongLong(), Q_UINT64_C(0x030201));
+    QCOMPARE(zclDecode(DATA_TYPE_48BIT_UNSIGNED, QByteArray::fromHex("ffffffffffff")).toULongLong(), Q_UINT64_C(0xFFFFFFFFFFFF));
+    QCOMPARE(zclDecode(DATA_TYPE_CHARACTER_STRING, QByteArray("abc")).toString(), QString("abc"));
+}
+
+void TestZcl::decodeSigned(void)
+{
+    QCOMPARE(zclDecode(DATA_TYPE_8BIT_SIGNED, QByteArray::fromHex("80")).toLongLong(), Q_INT64_C(-128));
+    QCOMPARE(zclDecode(DATA_TYPE_16BIT_SIGNED, QByteArray::fromHex("ff7f")).toLongLong(), Q_INT64_C(32767));
+    QCOMPARE(zclDecode(DATA_TYPE_24BIT_SIGNED, QByteArray::fromHex("feffff")).toLongLong(), Q_INT64_C(-2));
+    QCOMPARE(zclDecode(DATA_TYPE_24BIT_SIGNED, QByteArray::fromHex("ffff7f")).toLongLong(), Q_INT64_C(8388607));
+    QCOMPARE(zclDecode(DATA_TYPE_64BIT_SIGNED, QByteArray::fromHex("ffffffffffffffff")).toLongLong(), Q_INT64_C(-1));
+}
+
+void TestZcl::decodeFloat(void)
+{
+    QCOMPARE(zclDecode(DATA_TYPE_SEMI_PRECISION, QByteArray::fromHex("003c")).toDouble(), 1.0);
+    QCOMPARE(zclDecode(DATA_TYPE_SEMI_PRECISION, QByteArray::fromHex("00c0")).toDouble(), -2.0);
+    QCOMPARE(zclDecode(DATA_TYPE_SEMI_PRECISION, QByteArray::fromHex("ff7b")).toDouble(), 65504.0);
+    QCOMPARE(zclDecode(DATA_TYPE_SEMI_PRECISION, QByteArray::fromHex("0100")).toDouble(), ldexp(1.0, -24));
+    QVERIFY(qIsInf(zclDecode(DATA_TYPE_SEMI_PRECISION, QByteArray::fromHex("007c")).toDouble()));
+    QVERIFY(qIsNaN(zclDecode(DATA_TYPE_SEMI_PRECISION, QByteArray::fromHex("017c")).toDouble()));
+    QCOMPARE(zclDecode(DATA_TYPE_SINGLE_PRECISION, QByteArray::fromHex("0000c03f")).toDouble(), 1.5);
+    QCOMPARE(zclDecode(DATA_TYPE_DOUBLE_PRECISION, QByteArray::fromHex("00000000000004c0")).toDouble(), -2.5);
+}
+
+void TestZcl::decodeInvalid(void)
+{
+    QVERIFY(!zclDecode(DATA_TYPE_16BIT_UNSIGNED, QByteArray()).isValid());
+    QVERIFY(!zclDecode(DATA_TYPE_SINGLE_PRECISION, QByteArray::fromHex("0000")).isValid());
+    QVERIFY(!zclDecode(DATA_TYPE_ARRAY, QByteArray::fromHex("200100")).isValid());
+    QVERIFY(!zclDecode(0xFF, QByteArray::fromHex("00")).isValid());
+}
+
+void TestZcl::decodeShort(void)
+{
+    QCOMPARE(zclDecode(DATA_TYPE_16BIT_UNSIGNED, QByteArray::fromHex("ff")).toULongLong(), Q_UINT64_C(0xFF));
+    QCOMPARE(zclDecode(DATA_TYPE_32BIT_UNSIGNED, QByteArray::fromHex("3412")).toULongLong(), Q_UINT64_C(0x1234));
+    QCOMPARE(zclDecode(DATA_TYPE_16BIT_SIGNED, QByteArray::fromHex("ff")).toLongLong(), Q_INT64_C(-1));
+    QCOMPARE(zclDecode(DATA_TYPE_32BIT_SIGNED, QByteArray::fromHex("feff")).toLongLong(), Q_INT64_C(-2));
+    QCOMPARE(zclDecode(DATA_TYPE_32BIT_SIGNED, QByteArray::fromHex("ff7f")).toLongLong(), Q_INT64_C(32767));
+}
+
+void TestZcl::valueWidening(void)
+{
+    qint16 signedValue = 0;
+    quint16 unsignedValue = 0;
+    qint32 signedWide = 0;
+    quint32 unsignedWide = 0;
+
+    QVERIFY(zclValue(QByteArray::fromHex("ff"), signedValue));
+    QCOMPARE(signedValue, static_cast <qint16> (-1));
+
+    QVERIFY(zclValue(QByteArray::fromHex("ff"), unsignedValue));
+    QCOMPARE(unsignedValue, static_cast <quint16> (0x00FF));
+
+    QVERIFY(zclValue(QByteArray::fromHex("feffff"), signedWide));
+    QCOMPARE(signedWide, -2);
+
+    QVERIFY(zclValue(QByteArray::fromHex("feffff"), unsignedWide));
+    QCOMPARE(unsignedWide, static_cast <quint32> (0x00FFFFFE));
+
+    QVERIFY(zclValue(QByteArray::fromHex("3412"), signedValue));
+    QCOMPARE(signedValue, static_cast <qint16> (0x1234));
+
+    QVERIFY(!zclValue(QByteArray::fromHex("010203"), signedValue));
+    QVERIFY(!zclValue(QByteArray(), signedValue));
+}
+
+void TestZcl::dataSizeCursor(void)
+{
+    QByteArray data;
+    int offset = 2, i = 0, count = 0;
+
+    QCOMPARE(zclDataSize(DATA_TYPE_CHARACTER_STRING, QByteArray::fromHex("0542036162"), &offset), 3);
+    QCOMPARE(offset, 3);
+
+    offset = 2;
+    QCOMPARE(zclDataSize(DATA_TYPE_OCTET_STRING, QByteArray::fromHex("0541"), &offset), 0);
+
+    for (int j = 0; j < 100; j++)
+        data.append(QByteArray::fromHex("01213412"));
+
+    while (i + 2 < data.length())
+    {
+        int position = i + 2, size = zclDataSize(static_cast <quint8> (data.at(i + 1)), data, &position);
+
+        if (!size || position + size > data.length())
+            break;
+
+        i = position + size;
+        count++;
+    }
+
+    QCOMPARE(data.length(), 400);
+    QCOMPARE(i, data.length());
+    QCOMPARE(count, 100);
+}
+
+QTEST_APPLESS_MAIN(TestZcl)
+
+#include "tst_zcl.moc"
@@ -0,0 +1,15 @@
+QT += testlib
+QT -= gui
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_zcl
+INCLUDEPATH += ../..
+
+HEADERS += \
+    ../../zcl.h
+
+SOURCES += \
+    ../../zcl.cpp \
+    tst_zcl.cpp
@@ -0,0 +1,212 @@
+#include "topology.h"
+
+void LinkObject::update(quint8 linkQuality)
+{
+    m_history.append(linkQuality);
+
+    while (m_history.count() > LINK_HISTORY_SIZE)
+        m_history.removeFirst();
+}
+
+quint8 LinkObject::linkQuality(void)
+{
+    quint32 value = 0;
+
+    if (m_history.isEmpty())
+        return 0;
+
+    for (int i = 0; i < m_history.count(); i++)
+        value += m_history.at(i);
+
+    return static_cast <quint8> (value / m_history.count());
+}
+
+void Topology::updateLink(quint16 source, quint16 destination, quint8 linkQuality, Relationship relationship)
+{
+    auto it = m_links.find({source, destination});
+
+    if (it == m_links.end())
+        it = m_links.insert({source, destination}, Link(new LinkObject(source, destination)));
+
+    it.value()->update(linkQuality);
+    it.value()->setRelationship(relationship);
+    m_changed = true;
+}
+
+void Topology::updateNeighbors(quint16 networkAddress, const QList <quint16> &neighbors)
+{
+    for (auto it = m_links.begin(); it != m_links.end(); )
+    {
+        if (it.key().first != networkAddress || neighbors.contains(it.key().second))
+        {
+            it++;
+            continue;
+        }
+
+        it = m_links.erase(it);
+        m_changed = true;
+    }
+}
+
+void Topology::updateLinkQuality(quint16 networkAddress, quint8 linkQuality)
+{
+    QList <quint8> &history = m_linkQuality[networkAddress];
+
+    history.append(linkQuality);
+
+    while (history.count() > LINK_HISTORY_SIZE)
+        history.removeFirst();
+}
+
+void Topology::removeNode(quint16 networkAddress)
+{
+    for (auto it = m_links.begin(); it != m_links.end(); )
+    {
+        if (it.key().first != networkAddress && it.key().second != networkAddress)
+        {
+            it++;
+            continue;
+        }
+
+        it = m_links.erase(it);
+    }
+
+    m_linkQuality.remove(networkAddress);
+    m_routes.remove(networkAddress);
+    m_changed = true;
+}
+
+bool Topology::updateRoute(quint16 networkAddress, const QList <quint16> &relays)
+{
+    auto it = m_routes.find(networkAddress);
+    bool check = it != m_routes.end() && it.value() != relays;
+
+    m_routes.insert(networkAddress, relays);
+    return check;
+}
+
+void Topology::removeRoute(quint16 networkAddress)
+{
+    m_routes.remove(networkAddress);
+}
+
+int Topology::hops(quint16 networkAddress)
+{
+    auto it = m_routes.find(networkAddress);
+
+    if (it != m_routes.end())
+        return it.value().count() + 1;
+
+    if (m_changed)
+        update();
+
+    return m_hops.value(networkAddress, -1);
+}
+
+quint8 Topology::linkHealth(quint16 networkAddress)
+{
+    const QList <quint8> history = m_linkQuality.value(networkAddress);
+    quint32 value = 0;
+
+    if (m_changed)
+        update();
+
+    if (m_health.contains(networkAddress) || history.isEmpty())
+        return m_health.value(networkAddress);
+
+    for (int i = 0; i < history.count(); i++)
+        value += history.at(i);
+
+    return static_cast <quint8> (value / history.count());
+}
+
+QJsonObject Topology::serialize(void)
+{
+    QJsonArray nodes, links;
+    QMap <quint16, bool> list;
+
+    if (m_changed)
+        update();
+
+    for (auto it = m_links.begin(); it != m_links.end(); it++)
+    {
+        QJsonObject json = {{"source", it.key().first}, {"destination", it.key().second}, {"linkQuality", it.value()->linkQuality()}};
+
+        if (it.value()->relationship() != Relationship::None)
+            json.insert("relationship", static_cast <int> (it.value()->relationship()));
+
+        links.append(json);
+        list.insert(it.key().first, true);
+        list.insert(it.key().second, true);
+    }
+
+    for (auto it = m_linkQuality.begin(); it != m_linkQuality.end(); it++)
+        list.insert(it.key(), true);
+
+    for (auto it = m_routes.begin(); it != m_routes.end(); it++)
+        list.insert(it.key(), true);
+
+    for (auto it = list.begin(); it != list.end(); it++)
+    {
+        QJsonObject json = {{"networkAddress", it.key()}, {"linkHealth", linkHealth(it.key())}};
+        int count = hops(it.key());
+
+        if (count >= 0)
+            json.insert("hops", count);
+
+        if (m_routes.contains(it.key()))
+        {
+            const QList <quint16> relays = m_routes.value(it.key());
+            QJsonArray route;
+
+            for (int i = 0; i < relays.count(); i++)
+                route.append(relays.at(i));
+
+            json.insert("route", route);
+        }
+
+        nodes.append(json);
+    }
+
+    return {{"nodes", nodes}, {"links", links}, {"timestamp", QDateTime::currentSecsSinceEpoch()}};
+}
+
+void Topology::update(void)
+{
+    QMap <quint16, QList <QPair <quint16, quint8>>> map;
+    QList <quint16> queue = {0x0000};
+
+    for (auto it = m_links.begin(); it != m_links.end(); it++)
+    {
+        quint8 linkQuality = it.value()->linkQuality();
+
+        if (linkQuality < LINK_QUALITY_THRESHOLD)
+            continue;
+
+        map[it.key().first].append({it.key().second, linkQuality});
+        map[it.key().second].append({it.key().first, linkQuality});
+    }
+
+    m_hops = {{0x0000, 0}};
+    m_health = {{0x0000, 0xFF}};
+
+    while (!queue.isEmpty())
+    {
+        quint16 networkAddress = queue.takeFirst();
+        const QList <QPair <quint16, quint8>> list = map.value(networkAddress);
+
+        for (int i = 0; i < list.count(); i++)
+        {
+            const QPair <quint16, quint8> &item = list.at(i);
+
+            if (m_hops.contains(item.first))
+                continue;
+
+            m_hops.insert(item.first, m_hops.value(networkAddress) + 1);
+            m_health.insert(item.first, qMin(m_health.value(networkAddress), item.second));
+            queue.append(item.first);
+        }
+    }
+
+    m_changed = false;
+}
@@ -0,0 +1,89 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#define LINK_HISTORY_SIZE               8
+#define LINK_QUALITY_THRESHOLD          20
+#define LINK_HEALTH_THRESHOLD           60
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QSharedPointer>
+
+class LinkObject;
+typedef QSharedPointer <LinkObject> Link;
+
+enum class Relationship
+{
+    Parent,
+    Child,
+    Sibling,
+    None,
+    PreviousChild
+};
+
+class LinkObject
+{
+
+public:
+
+    LinkObject(quint16 source, quint16 destination) :
+        m_source(source), m_destination(destination), m_relationship(Relationship::None) {}
+
+    inline quint16 source(void) { return m_source; }
+    inline quint16 destination(void) { return m_destination; }
+
+    inline Relationship relationship(void) { return m_relationship; }
+    inline void setRelationship(Relationship value) { m_relationship = value; }
+
+    void update(quint8 linkQuality);
+    quint8 linkQuality(void);
+
+private:
+
+    quint16 m_source, m_destination;
+    Relationship m_relationship;
+
+    QList <quint8> m_history;
+
+};
+
+class Topology
+{
+
+public:
+
+    Topology(void) : m_changed(true) {}
+
+    inline QMap <QPair <quint16, quint16>, Link> &links(void) { return m_links; }
+    inline QMap <quint16, QList <quint16>> &routes(void) { return m_routes; }
+
+    void updateLink(quint16 source, quint16 destination, quint8 linkQuality, Relationship relationship = Relationship::None);
+    void updateNeighbors(quint16 networkAddress, const QList <quint16> &neighbors);
+    void updateLinkQuality(quint16 networkAddress, quint8 linkQuality);
+    void removeNode(quint16 networkAddress);
+
+    bool updateRoute(quint16 networkAddress, const QList <quint16> &relays);
+    void removeRoute(quint16 networkAddress);
+
+    int hops(quint16 networkAddress);
+    quint8 linkHealth(quint16 networkAddress);
+
+    QJsonObject serialize(void);
+
+private:
+
+    QMap <QPair <quint16, quint16>, Link> m_links;
+    QMap <quint16, QList <quint8>> m_linkQuality;
+    QMap <quint16, QList <quint16>> m_routes;
+
+    QMap <quint16, int> m_hops;
+    QMap <quint16, quint8> m_health;
+    bool m_changed;
+
+    void update(void);
+
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include <QLocale>
+#include <QtNumeric>
+#include "writer.h"
+
+const QByteArray &JsonWriter::write(const QMap <QString, QVariant> &map)
+{
+    m_buffer.resize(0);
+    writeMap(map);
+    return m_buffer;
+}
+
+void JsonWriter::writeMap(const QMap <QString, QVariant> &map)
+{
+    m_buffer.append('{');
+
+    for (auto it = map.begin(); it != map.end(); it++)
+    {
+        if (it != map.begin())
+            m_buffer.append(',');
+
+        writeString(it.key());
+        m_buffer.append(':');
+        writeValue(it.value());
+    }
+
+    m_buffer.append('}');
+}
+
+void JsonWriter::writeList(const QList <QVariant> &list)
+{
+    m_buffer.append('[');
+
+    for (int i = 0; i < list.count(); i++)
+    {
+        if (i)
+            m_buffer.append(',');
+
+        writeValue(list.at(i));
+    }
+
+    m_buffer.append(']');
+}
+
+void JsonWriter::writeValue(const QVariant &value)
+{
+    char buffer[24];
+
+    switch (value.userType())
+    {
+        case QMetaType::UnknownType:
+        case QMetaType::Nullptr:
+            m_buffer.append("null");
+            break;
+
+        case QMetaType::Bool:
+            m_buffer.append(value.toBool() ? "true" : "false");
+            break;
+
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::Short:
+        case QMetaType::Int:
+        case QMetaType::Long:
+        case QMetaType::LongLong:
+            m_buffer.append(buffer, qsnprintf(buffer, sizeof(buffer), "%lld", value.toLongLong()));
+            break;
+
+        case QMetaType::UChar:
+        case QMetaType::UShort:
+        case QMetaType::UInt:
+        case QMetaType::ULong:
+        case QMetaType::ULongLong:
+            m_buffer.append(buffer, qsnprintf(buffer, sizeof(buffer), "%llu", value.toULongLong()));
+            break;
+
+        case QMetaType::Float:
+        case QMetaType::Double:
+        {
+            double number = value.toDouble();
+
+            if (!qIsFinite(number))
+            {
+                m_buffer.append("null");
+                break;
+            }
+
+            m_buffer.append(QByteArray::number(number, 'g', QLocale::FloatingPointShortest));
+            break;
+        }
+
+        case QMetaType::QVariantMap:
+            writeMap(value.toMap());
+            break;
+
+        case QMetaType::QVariantList:
+        case QMetaType::QStringList:
+            writeList(value.toList());
+            break;
+
+        default:
+
+            if (!value.canConvert <QString> ())
+            {
+                m_buffer.append("null");
+                break;
+            }
+
+            writeString(value.toString());
+            break;
+    }
+}
+
+void JsonWriter::writeString(const QString &value)
+{
+    const QChar *data = value.constData();
+    int length = value.length();
+    char buffer[8];
+
+    m_buffer.append('"');
+
+    for (int i = 0; i < length; i++)
+    {
+        uint code = data[i].unicode();
+
+        if (data[i].isHighSurrogate() && i + 1 < length && data[i + 1].isLowSurrogate())
+        {
+            code = QChar::surrogateToUcs4(data[i], data[i + 1]);
+            i++;
+        }
+        else if (data[i].isSurrogate())
+            code = QChar::ReplacementCharacter;
+
+        switch (code)
+        {
+            case '"':  m_buffer.append("\\\""); continue;
+            case '\\': m_buffer.append("\\\\"); continue;
+            case '\b': m_buffer.append("\\b"); continue;
+            case '\f': m_buffer.append("\\f"); continue;
+            case '\n': m_buffer.append("\\n"); continue;
+            case '\r': m_buffer.append("\\r"); continue;
+            case '\t': m_buffer.append("\\t"); continue;
+        }
+
+        if (code < 0x20)
+        {
+            m_buffer.append(buffer, qsnprintf(buffer, sizeof(buffer), "\\u%04x", code));
+            continue;
+        }
+
+        if (code < 0x80)
+        {
+            m_buffer.append(static_cast <char> (code));
+            continue;
+        }
+
+        if (code < 0x800)
+        {
+            m_buffer.append(static_cast <char> (0xC0 | code >> 6));
+        }
+        else if (code < 0x10000)
+        {
+            m_buffer.append(static_cast <char> (0xE0 | code >> 12));
+            m_buffer.append(static_cast <char> (0x80 | (code >> 6 & 0x3F)));
+        }
+        else
+        {
+            m_buffer.append(static_cast <char> (0xF0 | code >> 18));
+            m_buffer.append(static_cast <char> (0x80 | (code >> 12 & 0x3F)));
+            m_buffer.append(static_cast <char> (0x80 | (code >> 6 & 0x3F)));
+        }
+
+        m_buffer.append(static_cast <char> (0x80 | (code & 0x3F)));
+    }
+
+    m_buffer.append('"');
+}
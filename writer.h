@@ -0,0 +1,29 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#define JSON_WRITER_RESERVE             1024
+
+#include <QMap>
+#include <QVariant>
+
+class JsonWriter
+{
+
+public:
+
+    JsonWriter(void) { m_buffer.reserve(JSON_WRITER_RESERVE); }
+
+    const QByteArray &write(const QMap <QString, QVariant> &map);
+
+private:
+
+    QByteArray m_buffer;
+
+    void writeMap(const QMap <QString, QVariant> &map);
+    void writeList(const QList <QVariant> &list);
+    void writeValue(const QVariant &value);
+    void writeString(const QString &value);
+
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include <QtEndian>
+#include <QtMath>
+#include <QtNumeric>
 #include "zcl.h"
 
 QByteArray zclHeader(quint8 frameControl, quint8 transactionId, quint8 commandId, quint16 manufacturerCode)
@@ -37,72 +39,196 @@ QByteArray writeAttributeRequest(quint8 transactionId, quint16 manufacturerCode,
     return zclHeader(FC_DISABLE_DEFAULT_RESPONSE, transactionId, CMD_WRITE_ATTRIBUTES, manufacturerCode).append(reinterpret_cast <char*> (&payload), sizeof(payload)).append(data);
 }
 
+static_assert(zclDataType(DATA_TYPE_24BIT_SIGNED).size == 3 && zclDataType(DATA_TYPE_24BIT_SIGNED).sign, "unexpected 24-bit signed descriptor");
+static_assert(zclDataType(DATA_TYPE_64BIT_BITMAP).size == 8 && zclDataType(DATA_TYPE_16BIT_ENUM).size == 2, "unexpected bitmap or enum descriptor");
+static_assert(zclDataType(DATA_TYPE_SINGLE_PRECISION).size == 4 && zclDataType(DATA_TYPE_DOUBLE_PRECISION).size == 8, "unexpected float descriptor");
+static_assert(zclDataType(DATA_TYPE_UTC_TIME).size == 4 && zclDataType(DATA_TYPE_IEEE_ADDRESS).size == 8, "unexpected identifier descriptor");
+static_assert(zclDataType(DATA_TYPE_CHARACTER_STRING).size == 0 && zclDataType(DATA_TYPE_ARRAY).size == 0, "variable length types must have no fixed size");
+
 quint8 zclDataSize(quint8 dataType)
+{
+    return zclDataType(dataType).size;
+}
+
+int zclDataSize(quint8 dataType, const QByteArray &data, int *offset)
 {
     switch (dataType)
     {
-        case DATA_TYPE_BOOLEAN:
-        case DATA_TYPE_8BIT_BITMAP:
-        case DATA_TYPE_8BIT_UNSIGNED:
-        case DATA_TYPE_8BIT_SIGNED:
-        case DATA_TYPE_8BIT_ENUM:
-            return 1;
-
-        case DATA_TYPE_16BIT_BITMAP:
-        case DATA_TYPE_16BIT_UNSIGNED:
-        case DATA_TYPE_16BIT_SIGNED:
-        case DATA_TYPE_16BIT_ENUM:
-            return 2;
-
-        case DATA_TYPE_24BIT_BITMAP:
-        case DATA_TYPE_24BIT_UNSIGNED:
-        case DATA_TYPE_24BIT_SIGNED:
-            return 3;
-
-        case DATA_TYPE_32BIT_BITMAP:
-        case DATA_TYPE_32BIT_UNSIGNED:
-        case DATA_TYPE_32BIT_SIGNED:
-        case DATA_TYPE_SINGLE_PRECISION:
-            return 4;
-
-        case DATA_TYPE_40BIT_BITMAP:
-        case DATA_TYPE_40BIT_UNSIGNED:
-        case DATA_TYPE_40BIT_SIGNED:
-            return 5;
-
-        case DATA_TYPE_48BIT_BITMAP:
-        case DATA_TYPE_48BIT_UNSIGNED:
-        case DATA_TYPE_48BIT_SIGNED:
-            return 6;
-
-        case DATA_TYPE_56BIT_BITMAP:
-        case DATA_TYPE_56BIT_UNSIGNED:
-        case DATA_TYPE_56BIT_SIGNED:
-            return 7;
-
-        case DATA_TYPE_64BIT_BITMAP:
-        case DATA_TYPE_64BIT_UNSIGNED:
-        case DATA_TYPE_64BIT_SIGNED:
-        case DATA_TYPE_DOUBLE_PRECISION:
-        case DATA_TYPE_IEEE_ADDRESS:
-            return 8;
+        case DATA_TYPE_OCTET_STRING:
+        case DATA_TYPE_CHARACTER_STRING:
+            return *offset < data.length() ? static_cast <quint8> (data.at((*offset)++)) : 0;
+
+        case DATA_TYPE_ARRAY:
+        case DATA_TYPE_STRUCTURE:
+            return qMax(data.length() - *offset, 0);
+    }
+
+    return zclDataSize(dataType);
+}
+
+QVariant zclDecode(quint8 dataType, const QByteArray &data)
+{
+    zclDataTypeStruct type = zclDataType(dataType);
+    quint64 value = 0;
+    int size;
+
+    switch (type.kind)
+    {
+        case DataTypeKind::String:
+            return dataType == DATA_TYPE_CHARACTER_STRING ? QVariant(QString(data)) : QVariant(QByteArray(data.constData(), data.length()));
+
+        case DataTypeKind::Unknown:
+        case DataTypeKind::Collection:
+            return QVariant();
+
+        default:
+            break;
+    }
+
+    if (data.isEmpty() || type.size > sizeof(value) || (type.kind == DataTypeKind::Float && data.length() < type.size))
+        return QVariant();
+
+    size = qMin <int> (data.length(), type.size);
+
+    for (int i = 0; i < size; i++)
+        value |= static_cast <quint64> (static_cast <quint8> (data.at(i))) << (8 * i);
+
+    switch (type.kind)
+    {
+        case DataTypeKind::Boolean:
+            return value ? true : false;
+
+        case DataTypeKind::Signed:
+
+            if (size < static_cast <int> (sizeof(value)) && value & (1ULL << (size * 8 - 1)))
+                value |= ~0ULL << (size * 8);
+
+            return static_cast <qint64> (value);
+
+        case DataTypeKind::Float:
+        {
+            switch (type.size)
+            {
+                case 2:
+                {
+                    int exponent = (value >> 10) & 0x1F;
+                    double result = exponent ? ldexp((value & 0x3FF) | 0x400, exponent - 25) : ldexp(value & 0x3FF, -24);
+
+                    if (exponent == 0x1F)
+                        result = value & 0x3FF ? qQNaN() : qInf();
+
+                    return value & 0x8000 ? -result : result;
+                }
+
+                case 4:
+                {
+                    quint32 bits = static_cast <quint32> (value);
+                    float result;
+                    memcpy(&result, &bits, sizeof(result));
+                    return result;
+                }
+
+                default:
+                {
+                    double result;
+                    memcpy(&result, &value, sizeof(result));
+                    return result;
+                }
+            }
+        }
+
+        default:
+            return value;
+    }
+}
+
+ZclFrame::ZclFrame(const QByteArray &data) : m_data(data), m_offset(0), m_frameControl(0), m_transactionId(0), m_commandId(0), m_manufacturerCode(0)
+{
+    if (m_data.isEmpty())
+        return;
+
+    m_frameControl = static_cast <quint8> (m_data.at(0));
+
+    if (m_frameControl & FC_MANUFACTURER_SPECIFIC)
+    {
+        if (m_data.length() < 5)
+            return;
+
+        memcpy(&m_manufacturerCode, m_data.constData() + 1, sizeof(m_manufacturerCode));
+        m_manufacturerCode = qFromLittleEndian(m_manufacturerCode);
+        m_transactionId = static_cast <quint8> (m_data.at(3));
+        m_commandId = static_cast <quint8> (m_data.at(4));
+        m_offset = 5;
     }
+    else
+    {
+        if (m_data.length() < 3)
+            return;
 
-    return 0;
+        m_transactionId = static_cast <quint8> (m_data.at(1));
+        m_commandId = static_cast <quint8> (m_data.at(2));
+        m_offset = 3;
+    }
 }
 
-quint8 zclDataSize(quint8 dataType, const QByteArray &data, quint8 *offset)
+bool ZclFrame::readAttribute(int &offset, quint16 &attributeId, quint8 &dataType, QByteArray &data, bool status) const
 {
+    const char *record = m_data.constData() + m_offset + offset;
+    int length = this->length() - offset, position = status ? 4 : 3, size;
+
+    if (offset < 0 || length <= 2)
+        return false;
+
+    memcpy(&attributeId, record, sizeof(attributeId));
+    attributeId = qFromLittleEndian(attributeId);
+
+    if (status && record[2])
+    {
+        dataType = DATA_TYPE_NO_DATA;
+        position = 3;
+    }
+    else
+    {
+        if (length < position)
+            return false;
+
+        dataType = static_cast <quint8> (record[position - 1]);
+    }
+
     switch (dataType)
     {
+        case DATA_TYPE_NO_DATA:
+            size = 0;
+            break;
+
         case DATA_TYPE_OCTET_STRING:
         case DATA_TYPE_CHARACTER_STRING:
-            return static_cast <quint8> (data.at((*offset)++));
+
+            if (position >= length)
+                return false;
+
+            size = static_cast <quint8> (record[position++]);
+            break;
 
         case DATA_TYPE_ARRAY:
         case DATA_TYPE_STRUCTURE:
-            return static_cast <quint8> (data.length() - *offset);
+            size = length - position;
+            break;
+
+        default:
+
+            size = zclDataSize(dataType);
+
+            if (!size)
+                return false;
+
+            break;
     }
 
-    return zclDataSize(dataType);
+    if (position + size > length)
+        return false;
+
+    data = QByteArray::fromRawData(record + position, size);
+    offset += position + size;
+    return true;
 }
@@ -25,6 +25,7 @@
 #define STATUS_INSUFFICIENT_SPACE                   0x89
 #define STATUS_DUPLICATE_EXISTS                     0x8A
 #define STATUS_NOT_FOUND                            0x8B
+#define STATUS_WAIT_FOR_DATA                        0x97
 #define STATUS_NO_IMAGE_AVAILABLE                   0x98
 
 #define DATA_TYPE_NO_DATA                           0x00
@@ -55,6 +56,7 @@
 #define DATA_TYPE_64BIT_SIGNED                      0x2F
 #define DATA_TYPE_8BIT_ENUM                         0x30
 #define DATA_TYPE_16BIT_ENUM                        0x31
+#define DATA_TYPE_SEMI_PRECISION                    0x38
 #define DATA_TYPE_SINGLE_PRECISION                  0x39
 #define DATA_TYPE_DOUBLE_PRECISION                  0x3A
 #define DATA_TYPE_OCTET_STRING                      0x41
@@ -120,7 +122,77 @@
 #define MANUFACTURER_CODE_SILABS                    0x1049
 #define MANUFACTURER_CODE_LUMI                      0x115F
 
+#include <QtEndian>
+#include <QByteArray>
 #include <QList>
+#include <QVariant>
+
+enum class DataTypeKind
+{
+    Unknown,
+    Data,
+    Boolean,
+    Bitmap,
+    Unsigned,
+    Signed,
+    Enum,
+    Float,
+    String,
+    Collection,
+    Time,
+    Identifier
+};
+
+struct zclDataTypeStruct
+{
+    quint8 size;
+    bool sign;
+    DataTypeKind kind;
+};
+
+constexpr zclDataTypeStruct zclDataType(quint8 dataType)
+{
+    return
+        dataType == DATA_TYPE_NO_DATA                   ? zclDataTypeStruct {0, false, DataTypeKind::Unknown} :
+        dataType >= 0x08 && dataType <= 0x0F            ? zclDataTypeStruct {static_cast <quint8> (dataType - 0x07), false, DataTypeKind::Data} :
+        dataType == DATA_TYPE_BOOLEAN                   ? zclDataTypeStruct {1, false, DataTypeKind::Boolean} :
+        dataType >= 0x18 && dataType <= 0x1F            ? zclDataTypeStruct {static_cast <quint8> (dataType - 0x17), false, DataTypeKind::Bitmap} :
+        dataType >= 0x20 && dataType <= 0x27            ? zclDataTypeStruct {static_cast <quint8> (dataType - 0x1F), false, DataTypeKind::Unsigned} :
+        dataType >= 0x28 && dataType <= 0x2F            ? zclDataTypeStruct {static_cast <quint8> (dataType - 0x27), true, DataTypeKind::Signed} :
+        dataType == DATA_TYPE_8BIT_ENUM                 ? zclDataTypeStruct {1, false, DataTypeKind::Enum} :
+        dataType == DATA_TYPE_16BIT_ENUM                ? zclDataTypeStruct {2, false, DataTypeKind::Enum} :
+        dataType == DATA_TYPE_SEMI_PRECISION            ? zclDataTypeStruct {2, true, DataTypeKind::Float} :
+        dataType == DATA_TYPE_SINGLE_PRECISION          ? zclDataTypeStruct {4, true, DataTypeKind::Float} :
+        dataType == DATA_TYPE_DOUBLE_PRECISION          ? zclDataTypeStruct {8, true, DataTypeKind::Float} :
+        dataType == DATA_TYPE_OCTET_STRING              ? zclDataTypeStruct {0, false, DataTypeKind::String} :
+        dataType == DATA_TYPE_CHARACTER_STRING          ? zclDataTypeStruct {0, false, DataTypeKind::String} :
+        dataType == DATA_TYPE_ARRAY                     ? zclDataTypeStruct {0, false, DataTypeKind::Collection} :
+        dataType == DATA_TYPE_STRUCTURE                 ? zclDataTypeStruct {0, false, DataTypeKind::Collection} :
+        dataType == 0x50 || dataType == 0x51            ? zclDataTypeStruct {0, false, DataTypeKind::Collection} :
+        dataType >= 0xE0 && dataType <= 0xE2            ? zclDataTypeStruct {4, false, DataTypeKind::Time} :
+        dataType == 0xE8 || dataType == 0xE9            ? zclDataTypeStruct {2, false, DataTypeKind::Identifier} :
+        dataType == 0xEA                                ? zclDataTypeStruct {4, false, DataTypeKind::Identifier} :
+        dataType == DATA_TYPE_IEEE_ADDRESS              ? zclDataTypeStruct {8, false, DataTypeKind::Identifier} :
+        dataType == 0xF1                                ? zclDataTypeStruct {16, false, DataTypeKind::Identifier} :
+                                                          zclDataTypeStruct {0, false, DataTypeKind::Unknown};
+}
+
+// shorter data is widened to T: zero-extended, or sign-extended for signed integer types, so unsigned attributes need unsigned T
+template <typename T>
+inline bool zclValue(const QByteArray &data, T &value)
+{
+    uchar buffer[sizeof(T)] = {};
+
+    if (data.isEmpty() || static_cast <size_t> (data.length()) > sizeof(T))
+        return false;
+
+    if (std::is_integral <T>::value && std::is_signed <T>::value && static_cast <quint8> (data.at(data.length() - 1)) & 0x80)
+        memset(buffer, 0xFF, sizeof(buffer));
+
+    memcpy(buffer, data.constData(), data.length());
+    value = qFromLittleEndian <T> (buffer);
+    return true;
+}
 
 #pragma pack(push, 1)
 
@@ -234,6 +306,26 @@ struct otaImageBlockResponseStruct
     quint8  dataSize;
 };
 
+struct otaImageBlockWaitStruct
+{
+    quint8  status;
+    quint32 currentTime;
+    quint32 requestTime;
+    quint16 minimumBlockPeriod;
+};
+
+struct otaImagePageRequestStruct
+{
+    quint8  fieldControl;
+    quint16 manufacturerCode;
+    quint16 imageType;
+    quint32 fileVersion;
+    quint32 fileOffset;
+    quint8  maxDataSize;
+    quint16 pageSize;
+    quint16 responseSpacing;
+};
+
 struct otaUpgradeEndRequestStruct
 {
     quint8  status;
@@ -345,6 +437,39 @@ QByteArray readAttributesRequest(quint8 transactionId, quint16 manufacturerCode,
 QByteArray writeAttributeRequest(quint8 transactionId, quint16 manufacturerCode, quint16 attributeId, quint8 dataType, const QByteArray &data);
 
 quint8 zclDataSize(quint8 dataType);
-quint8 zclDataSize(quint8 dataType, const QByteArray &data, quint8 *offset);
+int zclDataSize(quint8 dataType, const QByteArray &data, int *offset);
+QVariant zclDecode(quint8 dataType, const QByteArray &data);
+
+class ZclFrame
+{
+
+public:
+
+    ZclFrame(const QByteArray &data);
+
+    inline bool valid(void) const { return m_offset != 0; }
+
+    inline quint8 frameControl(void) const { return m_frameControl; }
+    inline quint16 manufacturerCode(void) const { return m_manufacturerCode; }
+    inline quint8 transactionId(void) const { return m_transactionId; }
+    inline quint8 commandId(void) const { return m_commandId; }
+
+    inline int length(void) const { return m_data.length() - m_offset; }
+    inline QByteArray payload(int offset = 0) const { return offset < length() ? QByteArray::fromRawData(m_data.constData() + m_offset + offset, length() - offset) : QByteArray(); }
+
+    template <class T>
+    inline const T *payload(int offset = 0) const { return offset >= 0 && length() - offset >= static_cast <int> (sizeof(T)) ? reinterpret_cast <const T*> (m_data.constData() + m_offset + offset) : nullptr; }
+
+    bool readAttribute(int &offset, quint16 &attributeId, quint8 &dataType, QByteArray &data, bool status) const;
+
+private:
+
+    QByteArray m_data;
+    int m_offset;
+
+    quint8 m_frameControl, m_transactionId, m_commandId;
+    quint16 m_manufacturerCode;
+
+};
 
 #endif
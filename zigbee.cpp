@@ -9,7 +9,7 @@
 #include "zigbee.h"
 #include "zstack.h"
 
-ZigBee::ZigBee(QSettings *config, QObject *parent) : QObject(parent), m_config(config), m_requestTimer(new QTimer(this)), m_neignborsTimer(new QTimer(this)), m_pingTimer(new QTimer(this)), m_statusLedTimer(new QTimer(this)), m_adapter(nullptr), m_devices(new DeviceList(m_config, this)), m_events(QMetaEnum::fromType <Event> ()), m_requestId(0), m_interPanLock(false)
+ZigBee::ZigBee(QSettings *config, QObject *parent) : QObject(parent), m_config(config), m_requestTimer(new QTimer(this)), m_neignborsTimer(new QTimer(this)), m_pingTimer(new QTimer(this)), m_otaTimer(new QTimer(this)), m_statusLedTimer(new QTimer(this)), m_adapter(nullptr), m_devices(new DeviceList(m_config, this)), m_events(QMetaEnum::fromType <Event> ()), m_requestId(0), m_interPanLock(false), m_otaRepository(nullptr), m_otaWatcher(new QFileSystemWatcher(this)), m_otaBudget({0, 0}), m_otaBackoffTime(0), m_otaBackoff(1), m_requestsDropped(0), m_requestsRejected(0), m_requestsCoalesced(0)
 {
     m_statusLedPin = m_config->value("gpio/status", "-1").toString();
     m_blinkLedPin = m_config->value("gpio/blink", "-1").toString();
@@ -17,9 +17,22 @@ ZigBee::ZigBee(QSettings *config, QObject *parent) : QObject(parent), m_config(c
     m_cloud = m_config->value("default/cloud", true).toBool();
     m_debug = m_config->value("debug/zigbee", false).toBool();
 
-    connect(m_devices, &DeviceList::statusUpdated, this, &ZigBee::statusUpdated);
+    m_queueLimit = m_config->value("zigbee/queueLimit", 192).toInt();
+    m_deviceQueueLimit = m_config->value("zigbee/deviceQueueLimit", 16).toInt();
+    m_queueReject = m_config->value("zigbee/queuePolicy", "drop").toString() == "reject";
+
+    m_otaBlockRate = m_config->value("ota/blockRate", 10).toDouble();
+    m_otaRouteBlockRate = m_config->value("ota/routeBlockRate", 4).toDouble();
+    m_otaMinimumBlockPeriod = static_cast <quint16> (m_config->value("ota/minimumBlockPeriod", 0).toInt());
+
+    if (!m_config->value("ota/directory").toString().isEmpty())
+        m_otaRepository = new OtaRepository(m_config->value("ota/directory").toString(), this);
+
+    connect(m_devices, &DeviceList::statusUpdated, this, &ZigBee::updateStatus);
     connect(m_devices, &DeviceList::endpointUpdated, this, &ZigBee::endpointUpdated);
     connect(m_devices, &DeviceList::pollRequest, this, &ZigBee::pollRequest);
+    connect(m_otaTimer, &QTimer::timeout, this, &ZigBee::otaStream);
+    connect(m_otaWatcher, &QFileSystemWatcher::fileChanged, this, &ZigBee::otaImageChanged);
     connect(m_statusLedTimer, &QTimer::timeout, this, &ZigBee::updateStatusLed);
 
     GPIO::direction(m_statusLedPin, GPIO::Output);
@@ -58,6 +71,7 @@ void ZigBee::init(void)
     connect(m_adapter, &Adapter::coordinatorReady, this, &ZigBee::coordinatorReady);
     connect(m_adapter, &Adapter::permitJoinUpdated, this, &ZigBee::permitJoinUpdated);
     connect(m_adapter, &Adapter::requestFinished, this, &ZigBee::requestFinished);
+    connect(m_adapter, &Adapter::routeReceived, this, &ZigBee::routeReceived);
 
     m_devices->init();
     m_adapter->init();
@@ -126,6 +140,7 @@ void ZigBee::updateDevice(const QString &deviceName, const QString &name, const
 
     if (check)
     {
+        device->setDirty(true);
         emit deviceEvent(device.data(), Event::deviceUpdated);
         m_devices->storeDatabase();
     }
@@ -147,6 +162,8 @@ void ZigBee::removeDevice(const QString &deviceName, bool force)
     logInfo << "Device" << device->name() << "removed (force)";
     emit deviceEvent(device.data(), Event::deviceRemoved);
 
+    m_otaSessions.remove(device->ieeeAddress());
+    m_topology.removeNode(device->networkAddress());
     m_devices->removeDevice(device);
     m_devices->storeDatabase();
 }
@@ -272,13 +289,23 @@ void ZigBee::otaUpgrade(const QString &deviceName, quint8 endpointId, const QStr
 {
     Device device = m_devices->byName(deviceName);
     otaImageNotifyStruct payload;
+    OtaImage image;
+
+    if (device.isNull() || device->removed() || !device->active() || device->logicalType() == LogicalType::Coordinator || fileName.isEmpty())
+        return;
+
+    image = otaImage(fileName);
 
-    if (device.isNull() || device->removed() || !device->active() || device->logicalType() == LogicalType::Coordinator || fileName.isEmpty() || !QFile::exists(fileName))
+    if (image.isNull())
+    {
+        logWarning << "Device" << device->name() << "OTA upgrade file" << fileName << "open error";
         return;
+    }
+
+    m_otaSessions.insert(device->ieeeAddress(), OtaSession(new OtaSessionObject(image, force, otaBlockPeriod())));
 
-    m_otaDevice = device;
-    m_otaFile.setFileName(fileName);
-    m_otaForce = force;
+    if (!m_otaTimer->isActive())
+        m_otaTimer->start(OTA_EXPIRE_INTERVAL);
 
     payload.type = 0x00;
     payload.jitter = 0x64; // TODO: check this
@@ -332,15 +359,59 @@ void ZigBee::touchLinkRequest(const QByteArray &ieeeAddress, quint8 channel, boo
     m_adapter->resetInterPanChannel();
 
     if (!m_requests.isEmpty())
-        m_requestTimer->start();
+        m_requestTimer->start(0);
 
     m_interPanLock = false;
 }
 
 void ZigBee::deviceAction(const QString &deviceName, quint8 endpointId, const QString &name, const QVariant &data)
 {
-    Device device = m_devices->byName(deviceName);
+    deviceAction(m_devices->byName(deviceName), endpointId, name, data);
+}
 
+void ZigBee::deviceActions(const QList <QVariant> &list)
+{
+    QMap <QString, Device> devices;
+    QMap <QString, int> index;
+    QList <QMap <QString, QVariant>> actions;
+
+    for (auto it = m_devices->begin(); it != m_devices->end(); it++)
+    {
+        devices.insert(it.value()->ieeeAddress().toHex(':'), it.value());
+        devices.insert(it.value()->ieeeAddress().toHex(), it.value());
+        devices.insert(it.value()->name(), it.value());
+    }
+
+    for (int i = 0; i < list.count(); i++)
+    {
+        QMap <QString, QVariant> item = list.at(i).toMap();
+        Device device = devices.value(item.value("device").toString());
+        QString key;
+
+        if (device.isNull() || !item.value("value").isValid())
+            continue;
+
+        key = QString("%1/%2/%3").arg(QString(device->ieeeAddress().toHex()), item.value("endpoint").toString(), item.value("action").toString());
+
+        if (index.contains(key))
+        {
+            actions[index.value(key)] = item;
+            continue;
+        }
+
+        index.insert(key, actions.count());
+        actions.append(item);
+    }
+
+    for (int i = 0; i < actions.count(); i++)
+    {
+        const QMap <QString, QVariant> &item = actions.at(i);
+        deviceAction(devices.value(item.value("device").toString()), static_cast <quint8> (item.value("endpoint").toInt()), item.value("action").toString(), item.value("value"));
+    }
+}
+
+void ZigBee::deviceAction(const Device &device, quint8 endpointId, const QString &name, const QVariant &data)
+{
     if (device.isNull() || device->removed() || !device->active() || device->logicalType() == LogicalType::Coordinator)
         return;
 
@@ -377,11 +448,11 @@ void ZigBee::deviceAction(const QString &deviceName, quint8 endpointId, const QS
 
 void ZigBee::groupAction(quint16 groupId, const QString &name, const QVariant &data)
 {
-    int type = QMetaType::type(QString(name).append("Action").toUtf8());
+    ActionObject *item = Registry <ActionObject>::create(name);
 
-    if (type)
+    if (item)
     {
-        Action action(reinterpret_cast <ActionObject*> (QMetaType::create(type)));
+        Action action(item);
         QByteArray request = action->request(name, data);
 
         if (request.isEmpty() || (data.type() == QVariant::String && data.toString().isEmpty()))
@@ -401,18 +472,123 @@ void ZigBee::enqueueRequest(const Device &device, quint8 endpointId, quint16 clu
 {
     DataRequest request(new DataRequestObject(device, endpointId, clusterId, data, name, debug, manufacturerCode, attributes));
 
-    if (!m_requestTimer->isActive() && !m_interPanLock)
-        m_requestTimer->start();
+    for (auto it = m_requests.begin(); it != m_requests.end(); it++)
+    {
+        if (it.value()->type() != RequestType::Data || it.value()->status() != RequestStatus::Pending || !coalesceRequest(request, qvariant_cast <DataRequest> (it.value()->data())))
+            continue;
+
+        it.value()->setStatus(RequestStatus::Aborted);
+        m_requestsCoalesced++;
+        break;
+    }
 
-    m_requests.insert(m_requestId++, Request(new RequestObject(QVariant::fromValue(request), RequestType::Data)));
+    insertRequest(device, Request(new RequestObject(QVariant::fromValue(request), RequestType::Data)));
 }
 
 void ZigBee::enqueueRequest(const Device &device, RequestType type)
 {
-    if (!m_requestTimer->isActive() && !m_interPanLock)
-        m_requestTimer->start();
+    insertRequest(device, Request(new RequestObject(QVariant::fromValue(device), type)));
+}
+
+void ZigBee::insertRequest(const Device &device, const Request &request)
+{
+    if (request->type() == RequestType::Data || request->type() == RequestType::LQI)
+    {
+        qint64 time = QDateTime::currentMSecsSinceEpoch();
+        auto oldest = m_requests.end(), deviceOldest = m_requests.end();
+        int count = 0, deviceCount = 0;
+
+        for (auto it = m_requests.begin(); it != m_requests.end(); it++)
+        {
+            if (it.value()->status() == RequestStatus::Sent && time - it.value()->sentTime() > REQUEST_QUEUE_TIMEOUT)
+                it.value()->setStatus(RequestStatus::Aborted);
+
+            if (it.value()->type() != request->type() || it.value()->status() != RequestStatus::Pending)
+                continue;
+
+            if (oldest == m_requests.end() || it.value()->time() < oldest.value()->time())
+                oldest = it;
+
+            count++;
+
+            if (requestDevice(it.value()) != device)
+                continue;
+
+            if (deviceOldest == m_requests.end() || it.value()->time() < deviceOldest.value()->time())
+                deviceOldest = it;
+
+            deviceCount++;
+        }
+
+        if (count >= m_queueLimit || deviceCount >= m_deviceQueueLimit)
+        {
+            if (m_queueReject)
+            {
+                logWarning << "Device" << device->name() << "request rejected, request queue is full";
+                emit deviceEvent(device.data(), Event::requestRejected, {{"queue", deviceCount >= m_deviceQueueLimit ? "device" : "network"}});
+                m_requestsRejected++;
+                return;
+            }
+
+            (deviceCount >= m_deviceQueueLimit ? deviceOldest : oldest).value()->setStatus(RequestStatus::Aborted);
+            m_requestsDropped++;
+        }
+    }
+
+    if (m_requests.contains(m_requestId) && (m_requests.value(m_requestId)->status() == RequestStatus::Pending || m_requests.value(m_requestId)->status() == RequestStatus::Sent))
+        m_requestsDropped++;
+
+    if ((!m_requestTimer->isActive() || m_requestTimer->interval()) && !m_interPanLock)
+        m_requestTimer->start(0);
+
+    m_requests.insert(m_requestId++, request);
+}
+
+bool ZigBee::coalesceRequest(const DataRequest &request, const DataRequest &other)
+{
+    ZclFrame frame(request->data()), item(other->data());
+    QList <quint16> list[2];
 
-    m_requests.insert(m_requestId++, Request(new RequestObject(QVariant::fromValue(device), type)));
+    if (request->device() != other->device() || request->endpointId() != other->endpointId() || request->clusterId() != other->clusterId())
+        return false;
+
+    if (!frame.valid() || !item.valid() || frame.frameControl() & FC_CLUSTER_SPECIFIC || frame.frameControl() != item.frameControl() || frame.manufacturerCode() != item.manufacturerCode() || frame.commandId() != item.commandId())
+        return false;
+
+    switch (frame.commandId())
+    {
+        case CMD_READ_ATTRIBUTES:
+            return frame.payload() == item.payload();
+
+        case CMD_WRITE_ATTRIBUTES:
+        {
+            const ZclFrame *frames[2] = {&frame, &item};
+
+            for (int i = 0; i < 2; i++)
+            {
+                int offset = 0;
+                quint16 attributeId;
+                quint8 dataType;
+                QByteArray data;
+
+                while (frames[i]->readAttribute(offset, attributeId, dataType, data, false))
+                    list[i].append(attributeId);
+
+                if (offset != frames[i]->length())
+                    return false;
+            }
+
+            return !list[0].isEmpty() && list[0] == list[1];
+        }
+
+        default:
+            return false;
+    }
+}
+
+Device ZigBee::requestDevice(const Request &request)
+{
+    return request->type() == RequestType::Data ? qvariant_cast <DataRequest> (request->data())->device() : qvariant_cast <Device> (request->data());
 }
 
 bool ZigBee::interviewRequest(quint8 id, const Device &device)
@@ -769,6 +945,8 @@ void ZigBee::parseAttribute(const Endpoint &endpoint, quint16 clusterId, quint8
                 break;
         }
 
+        device->setDirty(true);
+
         if (!device->interviewFinished() && !device->manufacturerName().isEmpty() && !device->modelName().isEmpty() && (attributeId == 0x0004 || attributeId == 0x0005))
             interviewDevice(device);
 
@@ -876,7 +1054,7 @@ void ZigBee::parseAttribute(const Endpoint &endpoint, quint16 clusterId, quint8
             if (property->timeout())
                 property->setTime(QDateTime::currentSecsSinceEpoch());
 
-            if (property->value() == value)
+            if (!property->filterValue(value) || property->value() == value)
                 continue;
 
             endpoint->setUpdated(true);
@@ -889,9 +1067,12 @@ void ZigBee::parseAttribute(const Endpoint &endpoint, quint16 clusterId, quint8
     logWarning << "No property found for device" << device->name() << "endpoint" << QString::asprintf("0x%02x", endpoint->id()) << "cluster" << QString::asprintf("0x%04x", clusterId) << "attribute" << QString::asprintf("0x%04x", attributeId) << "report with type" << QString::asprintf("0x%02x", dataType) << "and data" << (data.isEmpty() ? "(empty)" : data.toHex(':'));
 }
 
-void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId, quint16 manufacturerCode, quint8 transactionId, quint8 commandId, const QByteArray &payload)
+void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId, const ZclFrame &frame)
 {
     Device device = endpoint->device();
+    quint16 manufacturerCode = frame.manufacturerCode();
+    quint8 transactionId = frame.transactionId(), commandId = frame.commandId();
+    QByteArray payload = frame.payload();
     bool check = false;
 
     if (m_debug)
@@ -907,7 +1088,10 @@ void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId,
             case 0x00:
             case 0x03:
             {
-                const groupControlResponseStruct *response = reinterpret_cast <const groupControlResponseStruct*> (payload.constData());
+                const groupControlResponseStruct *response = frame.payload <groupControlResponseStruct> ();
+
+                if (!response)
+                    break;
 
                 switch (response->status)
                 {
@@ -945,46 +1129,64 @@ void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId,
 
     if (clusterId == CLUSTER_OTA_UPGRADE)
     {
-        otaFileHeaderStruct header;
+        OtaSession session = m_otaSessions.value(device->ieeeAddress());
+        const otaFileHeaderStruct *header;
 
-        if (device != m_otaDevice)
+        if (session.isNull() && m_otaRepository && (commandId == 0x01 || commandId == 0x03 || commandId == 0x04) && frame.payload <otaNextImageRequestStruct> ())
         {
-            otaError(endpoint, manufacturerCode, transactionId, commandId);
-            return;
+            const otaNextImageRequestStruct *request = frame.payload <otaNextImageRequestStruct> ();
+            QString fileName = m_otaRepository->find(qFromLittleEndian(request->manufacturerCode), qFromLittleEndian(request->imageType), qFromLittleEndian(request->fileVersion), commandId != 0x01);
+            OtaImage image = fileName.isEmpty() ? OtaImage() : otaImage(fileName);
+
+            if (!image.isNull())
+            {
+                logInfo << "Device" << device->name() << "OTA upgrade image" << fileName << "matched";
+                session = OtaSession(new OtaSessionObject(image, false, otaBlockPeriod()));
+                m_otaSessions.insert(device->ieeeAddress(), session);
+
+                if (!m_otaTimer->isActive())
+                    m_otaTimer->start(OTA_EXPIRE_INTERVAL);
+            }
         }
 
-        if (!m_otaFile.exists() || !m_otaFile.open(QFile::ReadOnly))
+        if (session.isNull())
         {
-            otaError(endpoint, manufacturerCode, transactionId, commandId, "OTA upgrade failed, file open error");
+            otaError(endpoint, manufacturerCode, transactionId, commandId);
             return;
         }
 
-        memcpy(&header, m_otaFile.read(sizeof(header)).constData(), sizeof(header));
+        header = session->image()->header();
+        session->setTime(QDateTime::currentMSecsSinceEpoch());
 
         switch (commandId)
         {
             case 0x01:
             {
-                const otaNextImageRequestStruct *request = reinterpret_cast <const otaNextImageRequestStruct*> (payload.constData());
+                const otaNextImageRequestStruct *request = frame.payload <otaNextImageRequestStruct> ();
                 otaNextImageResponseStruct response;
 
-                if (!m_otaForce && (request->manufacturerCode != header.manufacturerCode || request->imageType != header.imageType))
+                if (!request)
+                    break;
+
+                if (!session->force() && (request->manufacturerCode != header->manufacturerCode || request->imageType != header->imageType))
                 {
                     otaError(endpoint, manufacturerCode, transactionId, commandId, "OTA upgrade image request failed, header data mismatch request data");
                     break;
                 }
 
-                if (request->fileVersion == header.fileVersion)
+                if (request->fileVersion == header->fileVersion)
                 {
                     otaError(endpoint, manufacturerCode, transactionId, commandId, QString::asprintf("OTA upgrade not started, version match: 0x%08x", qFromLittleEndian(request->fileVersion)).toUtf8().constData());
                     break;
                 }
 
+                session->setBlockPeriod(otaBlockPeriod());
+
                 response.status = 0x00;
-                response.manufacturerCode = m_otaForce ? request->manufacturerCode : header.manufacturerCode;
-                response.imageType = m_otaForce ? request->imageType : header.imageType;
-                response.fileVersion = header.fileVersion;
-                response.imageSize = header.imageSize;
+                response.manufacturerCode = session->force() ? request->manufacturerCode : header->manufacturerCode;
+                response.imageType = session->force() ? request->imageType : header->imageType;
+                response.fileVersion = header->fileVersion;
+                response.imageSize = header->imageSize;
 
                 logInfo << "Device" << device->name() << "OTA upgrade started...";
                 enqueueRequest(device, endpoint->id(), CLUSTER_OTA_UPGRADE, zclHeader(FC_CLUSTER_SPECIFIC | FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, transactionId, 0x02).append(reinterpret_cast <char*> (&response), sizeof(response)));
@@ -993,41 +1195,80 @@ void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId,
 
             case 0x03:
             {
-                const otaImageBlockRequestStruct *request = reinterpret_cast <const otaImageBlockRequestStruct*> (payload.constData());
-                otaImageBlockResponseStruct response;
-                QByteArray block;
+                const otaImageBlockRequestStruct *request = frame.payload <otaImageBlockRequestStruct> ();
+                quint16 period;
+
+                if (!request)
+                    break;
 
-                if (!m_otaForce && (request->manufacturerCode != header.manufacturerCode || request->imageType != header.imageType || request->fileVersion != header.fileVersion))
+                if (!session->force() && (request->manufacturerCode != header->manufacturerCode || request->imageType != header->imageType || request->fileVersion != header->fileVersion))
                 {
                     otaError(endpoint, manufacturerCode, transactionId, commandId, "OTA upgrade block request failed, header data mismatch request data");
                     break;
                 }
 
-                m_otaFile.seek(qFromLittleEndian(request->fileOffset));
-                block = m_otaFile.read(request->maxDataSize);
+                session->start();
+                period = otaBlockPeriod();
 
-                response.status = 0x00;
-                response.manufacturerCode = request->manufacturerCode;
-                response.imageType = request->imageType;
-                response.fileVersion = request->fileVersion;
-                response.fileOffset = request->fileOffset;
-                response.dataSize = static_cast <quint8> (block.length());
+                if (period > session->blockPeriod())
+                {
+                    session->setBlockPeriod(period);
+                    otaWait(endpoint, transactionId, 0, period);
+                    break;
+                }
+
+                if (!otaBudget(device))
+                {
+                    otaWait(endpoint, transactionId, OTA_WAIT_DELAY, period);
+                    break;
+                }
+
+                otaImageBlock(endpoint, session, transactionId, request->manufacturerCode, request->imageType, request->fileVersion, qFromLittleEndian(request->fileOffset), request->maxDataSize);
+                break;
+            }
+
+            case 0x04:
+            {
+                const otaImagePageRequestStruct *request = frame.payload <otaImagePageRequestStruct> ();
+
+                if (!request)
+                {
+                    otaError(endpoint, manufacturerCode, transactionId, commandId, "OTA upgrade page request failed, payload is too short");
+                    break;
+                }
+
+                if (!session->force() && (request->manufacturerCode != header->manufacturerCode || request->imageType != header->imageType || request->fileVersion != header->fileVersion))
+                {
+                    otaError(endpoint, manufacturerCode, transactionId, commandId, "OTA upgrade page request failed, header data mismatch request data");
+                    break;
+                }
+
+                session->startPage(endpoint->id(), transactionId, *request);
+
+                if (!m_otaTimer->isActive() || m_otaTimer->interval() != OTA_STREAM_INTERVAL)
+                    m_otaTimer->start(OTA_STREAM_INTERVAL);
 
-                logInfo << "Device" << device->name() << "OTA upgrade progress is" << QString::asprintf("%.2f%%", static_cast <double> (m_otaFile.pos() + block.size()) / m_otaFile.size() * 100).toUtf8().constData();
-                enqueueRequest(device, endpoint->id(), CLUSTER_OTA_UPGRADE, zclHeader(FC_CLUSTER_SPECIFIC | FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, transactionId, 0x05).append(reinterpret_cast <char*> (&response), sizeof(response)).append(block));
                 break;
             }
             case 0x06:
             {
-                const otaUpgradeEndRequestStruct *request = reinterpret_cast <const otaUpgradeEndRequestStruct*> (payload.constData());
+                const otaUpgradeEndRequestStruct *request = frame.payload <otaUpgradeEndRequestStruct> ();
                 otaUpgradeEndResponseStruct response;
 
+                if (!request)
+                    break;
+
+                m_otaSessions.remove(device->ieeeAddress());
+
                 if (request->status)
                 {
                     logWarning << "Device" << device->name() << "OTA upgrade finished with error, status code:" << QString::asprintf("0x%02x", request->status);
                     break;
                 }
 
+                if (session->started())
+                    logInfo << "Device" << device->name() << "OTA upgrade transfer took" << QString::asprintf("%.1f", static_cast <double> (QDateTime::currentMSecsSinceEpoch() - session->started()) / 1000).toUtf8().constData() << "seconds in" << (session->pageMode() ? "page" : "block") << "mode";
+
                 response.manufacturerCode = request->manufacturerCode;
                 response.imageType = request->imageType;
                 response.fileVersion = request->fileVersion;
@@ -1045,9 +1286,6 @@ void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId,
                 break;
         }
 
-        if (m_otaFile.isOpen())
-            m_otaFile.close();
-
         return;
     }
 
@@ -1103,7 +1341,7 @@ void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId,
             if (property->timeout())
                 property->setTime(QDateTime::currentSecsSinceEpoch());
 
-            if (property->value() == value)
+            if (!property->filterValue(value) || property->value() == value)
                 continue;
 
             endpoint->setUpdated(true);
@@ -1116,22 +1354,25 @@ void ZigBee::clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId,
     logWarning << "No property found for device" << device->name() << "endpoint" << QString::asprintf("0x%02x", endpoint->id()) << "cluster" << QString::asprintf("0x%04x", clusterId) << "command" << QString::asprintf("0x%02x", commandId) << "with payload" << (payload.isEmpty() ? "(empty)" : payload.toHex(':'));
 }
 
-void ZigBee::globalCommandReceived(const Endpoint &endpoint, quint16 clusterId, quint16 manufacturerCode, quint8 transactionId, quint8 commandId, QByteArray payload)
+void ZigBee::globalCommandReceived(const Endpoint &endpoint, quint16 clusterId, const ZclFrame &frame)
 {
     Device device = endpoint->device();
+    quint16 manufacturerCode = frame.manufacturerCode();
+    quint8 transactionId = frame.transactionId(), commandId = frame.commandId();
+    QByteArray payload = frame.payload();
 
     switch (commandId)
     {
         case CMD_CONFIGURE_REPORTING_RESPONSE:
 
-            if (payload.at(0))
+            if (!payload.isEmpty() && payload.at(0))
                 logWarning << "Device" << device->name() << "endpoint" << QString::asprintf("0x%02x", endpoint->id()) << "cluster" << QString::asprintf("0x%04x", clusterId) << "reporting configuration error, status code:" << QString::asprintf("0x%02x", static_cast <quint8> (payload.at(0)));
 
             break;
 
         case CMD_DEFAULT_RESPONSE:
 
-            if (payload.at(1))
+            if (payload.length() > 1 && payload.at(1))
                 logWarning << "Device" << device->name() << "endpoint" << QString::asprintf("0x%02x", endpoint->id()) << "cluster" << QString::asprintf("0x%04x", clusterId) << "command" << QString::asprintf("0x%02x", payload.at(0)) << "default response received with error, status code:" << QString::asprintf("0x%02x", static_cast <quint8> (payload.at(1)));
 
             break;
@@ -1141,7 +1382,7 @@ void ZigBee::globalCommandReceived(const Endpoint &endpoint, quint16 clusterId,
             QByteArray response = zclHeader(FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, transactionId, CMD_READ_ATTRIBUTES_RESPONSE, manufacturerCode);
             quint16 attributeId;
 
-            for (quint8 i = 0; i < payload.length(); i += sizeof(attributeId))
+            for (int i = 0; i + static_cast <int> (sizeof(attributeId)) <= payload.length(); i += sizeof(attributeId))
             {
                 memcpy(&attributeId, payload.constData() + i, sizeof(attributeId));
                 attributeId = qFromLittleEndian(attributeId);
@@ -1199,51 +1440,23 @@ void ZigBee::globalCommandReceived(const Endpoint &endpoint, quint16 clusterId,
         case CMD_READ_ATTRIBUTES_RESPONSE:
         case CMD_REPORT_ATTRIBUTES:
         {
-            while (payload.length() > 2)
-            {
-                quint8 dataType, offset, size = 0;
-                quint16 attributeId;
-
-                memcpy(&attributeId, payload.constData(), sizeof(attributeId));
-                attributeId = qFromLittleEndian(attributeId);
-
-                if (commandId == CMD_READ_ATTRIBUTES_RESPONSE)
-                {
-                    if (!payload.at(2))
-                    {
-                        dataType = static_cast <quint8> (payload.at(3));
-                        offset = 4;
-                    }
-                    else
-                    {
-                        dataType = DATA_TYPE_NO_DATA;
-                        offset = 3;
-                    }
-                }
-                else
-                {
-                    dataType = static_cast <quint8> (payload.at(2));
-                    offset = 3;
-                }
+            quint16 attributeId;
+            quint8 dataType;
+            QByteArray data;
+            int offset = 0;
 
-                size = zclDataSize(dataType, payload, &offset);
+            while (frame.readAttribute(offset, attributeId, dataType, data, commandId == CMD_READ_ATTRIBUTES_RESPONSE))
+                parseAttribute(endpoint, clusterId, transactionId, attributeId, dataType, data);
 
-                if (dataType != DATA_TYPE_NO_DATA && dataType != DATA_TYPE_OCTET_STRING && dataType != DATA_TYPE_CHARACTER_STRING && !size)
-                {
-                    logWarning << "Unrecognized attribute" << QString::asprintf("0x%04x", attributeId) << "type" << QString::asprintf("0x%02x", dataType) << "received from device" << device->name() << "endpoint" << QString::asprintf("0x%02x", endpoint->id()) << "cluster" << QString::asprintf("0x%04x", clusterId) << "with payload:" << payload.mid(offset).toHex(':');
-                    return;
-                }
-
-                parseAttribute(endpoint, clusterId, transactionId, attributeId, dataType, payload.mid(offset, size));
-                payload.remove(0, offset + size);
-            }
+            if (frame.length() - offset > 2)
+                logWarning << "Unrecognized or truncated attribute record received from device" << device->name() << "endpoint" << QString::asprintf("0x%02x", endpoint->id()) << "cluster" << QString::asprintf("0x%04x", clusterId) << "with payload:" << frame.payload(offset).toHex(':');
 
             break;
         }
 
         case CMD_WRITE_ATTRIBUTES_RESPONSE:
         {
-            if (clusterId == CLUSTER_IAS_ZONE && !payload.at(0))
+            if (clusterId == CLUSTER_IAS_ZONE && !payload.isEmpty() && !payload.at(0))
             {
                 endpoint->setZoneStatus(ZoneStatus::Enroll);
                 interviewDevice(device);
@@ -1344,6 +1557,142 @@ void ZigBee::rejoinHandler(const Device &device)
         enqueueRequest(device, 0x01, CLUSTER_TUYA_DATA, zclHeader(FC_CLUSTER_SPECIFIC, m_requestId, 0x03), "data query request");
 }
 
+OtaImage ZigBee::otaImage(const QString &fileName)
+{
+    QString path = QFileInfo(fileName).canonicalFilePath();
+    OtaImage image;
+
+    if (path.isEmpty())
+        return OtaImage();
+
+    for (auto it = m_otaImages.begin(); it != m_otaImages.end(); )
+    {
+        if (!it.value().isNull())
+        {
+            it++;
+            continue;
+        }
+
+        m_otaWatcher->removePath(it.key());
+        it = m_otaImages.erase(it);
+    }
+
+    image = m_otaImages.value(path).toStrongRef();
+
+    if (!image.isNull())
+        return image;
+
+    image = OtaImage(new OtaImageObject(path));
+
+    if (!image->valid())
+        return OtaImage();
+
+    m_otaImages.insert(path, image);
+    m_otaWatcher->addPath(path);
+    return image;
+}
+
+int ZigBee::otaImageBlock(const Endpoint &endpoint, const OtaSession &session, quint8 transactionId, quint16 manufacturerCode, quint16 imageType, quint32 fileVersion, quint32 fileOffset, quint8 maxDataSize)
+{
+    Device device = endpoint->device();
+    QByteArray block = session->image()->block(fileOffset, maxDataSize);
+    otaImageBlockResponseStruct response;
+    int progress;
+
+    response.status = 0x00;
+    response.manufacturerCode = manufacturerCode;
+    response.imageType = imageType;
+    response.fileVersion = fileVersion;
+    response.fileOffset = qToLittleEndian(fileOffset);
+    response.dataSize = static_cast <quint8> (block.length());
+
+    logInfo << "Device" << device->name() << "OTA upgrade progress is" << QString::asprintf("%.2f%%", static_cast <double> (fileOffset + block.size()) / session->image()->size() * 100).toUtf8().constData();
+    enqueueRequest(device, endpoint->id(), CLUSTER_OTA_UPGRADE, zclHeader(FC_CLUSTER_SPECIFIC | FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, transactionId, 0x05).append(reinterpret_cast <char*> (&response), sizeof(response)).append(block));
+
+    progress = static_cast <int> (static_cast <qint64> (fileOffset + block.size()) * 100 / session->image()->size());
+
+    if (session->progress() != progress)
+    {
+        session->setProgress(progress);
+        emit deviceEvent(device.data(), Event::otaUpgradeProgress, {{"progress", progress}});
+    }
+
+    return block.length();
+}
+
+quint16 ZigBee::otaBlockPeriod(void)
+{
+    if (m_otaRouteBlockRate <= 0)
+        return m_otaMinimumBlockPeriod;
+
+    return static_cast <quint16> (qMax <double> (m_otaMinimumBlockPeriod, qMin <double> (1000 * m_otaBackoff / m_otaRouteBlockRate, 0xFFFF)));
+}
+
+bool ZigBee::otaBudget(const Device &device)
+{
+    QList <quint16> relays = m_topology.routes().value(device->networkAddress());
+    otaBudgetStruct &route = m_otaRouteBudget[relays.isEmpty() ? device->networkAddress() : relays.last()];
+    qint64 time = QDateTime::currentMSecsSinceEpoch();
+    bool busy = false;
+
+    for (auto it = m_requests.begin(); it != m_requests.end(); it++)
+    {
+        if (it.value()->type() != RequestType::Data || it.value()->status() != RequestStatus::Pending || qvariant_cast <DataRequest> (it.value()->data())->clusterId() == CLUSTER_OTA_UPGRADE)
+            continue;
+
+        busy = true;
+        break;
+    }
+
+    if (time - m_otaBackoffTime >= OTA_BACKOFF_INTERVAL)
+    {
+        m_otaBackoff = busy ? qMin(m_otaBackoff * 2, OTA_BACKOFF_LIMIT) : qMax(m_otaBackoff / 2, 1);
+        m_otaBackoffTime = time;
+    }
+
+    if (m_otaBlockRate > 0)
+    {
+        double rate = m_otaBlockRate / m_otaBackoff;
+
+        m_otaBudget.tokens = qMin(m_otaBudget.tokens + (time - m_otaBudget.time) * rate / 1000, qMax(rate, 1.0));
+        m_otaBudget.time = time;
+
+        if (m_otaBudget.tokens < 1)
+            return false;
+    }
+
+    if (m_otaRouteBlockRate > 0)
+    {
+        double rate = m_otaRouteBlockRate / m_otaBackoff;
+
+        route.tokens = qMin(route.tokens + (time - route.time) * rate / 1000, qMax(rate, 1.0));
+        route.time = time;
+
+        if (route.tokens < 1)
+            return false;
+
+        route.tokens--;
+    }
+
+    if (m_otaBlockRate > 0)
+        m_otaBudget.tokens--;
+
+    return true;
+}
+
+void ZigBee::otaWait(const Endpoint &endpoint, quint8 transactionId, quint32 delay, quint16 minimumBlockPeriod)
+{
+    otaImageBlockWaitStruct response;
+    quint32 time = static_cast <quint32> (QDateTime::currentSecsSinceEpoch() - TIME_OFFSET);
+
+    response.status = STATUS_WAIT_FOR_DATA;
+    response.currentTime = qToLittleEndian(time);
+    response.requestTime = qToLittleEndian(time + delay);
+    response.minimumBlockPeriod = qToLittleEndian(minimumBlockPeriod);
+
+    enqueueRequest(endpoint->device(), endpoint->id(), CLUSTER_OTA_UPGRADE, zclHeader(FC_CLUSTER_SPECIFIC | FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, transactionId, 0x05).append(reinterpret_cast <char*> (&response), sizeof(response)));
+}
+
 void ZigBee::otaError(const Endpoint &endpoint, quint16 manufacturerCode, quint8 transactionId, quint8 commandId, const QString &error)
 {
     Device device = endpoint->device();
@@ -1412,17 +1761,28 @@ void ZigBee::coordinatorReady(void)
     connect(m_pingTimer, &QTimer::timeout, this, &ZigBee::pingDevices, Qt::UniqueConnection);
 
     if (!m_requests.isEmpty())
-        m_requestTimer->start();
+        m_requestTimer->start(0);
 
     if (!m_neignborsTimer->isActive())
-        m_neignborsTimer->start(UPDATE_NEIGHBORS_INTERVAL);
+        m_neignborsTimer->start(NEIGHBORS_SCAN_INTERVAL);
 
     if (!m_pingTimer->isActive())
     {
-        m_pingTimer->start(PING_DEVICES_INTERVAL);
+        m_pingTimer->start(PING_SCAN_INTERVAL);
         pingDevices();
     }
 
+    for (auto it = m_devices->begin(); it != m_devices->end(); it++)
+    {
+        for (auto item = it.value()->neighbors().begin(); item != it.value()->neighbors().end(); item++)
+        {
+            if (m_topology.links().contains({it.value()->networkAddress(), item.key()}))
+                continue;
+
+            m_topology.updateLink(it.value()->networkAddress(), item.key(), item.value());
+        }
+    }
+
     m_adapter->setPermitJoin(m_devices->permitJoin());
     emit networkStarted();
 }
@@ -1473,11 +1833,13 @@ void ZigBee::deviceJoined(const QByteArray &ieeeAddress, quint16 networkAddress)
 
     it.value()->updateJoinTime();
     it.value()->updateLastSeen();
+    emit deviceSeen(it.value().data());
     blink(500);
 
     if (it.value()->networkAddress() != networkAddress)
     {
         logInfo << "Device" << it.value()->name() << "network address updated";
+        m_topology.removeNode(it.value()->networkAddress());
         it.value()->setNetworkAddress(networkAddress);
     }
 
@@ -1503,6 +1865,8 @@ void ZigBee::deviceLeft(const QByteArray &ieeeAddress)
     logInfo << "Device" << it.value()->name() << "left network";
     emit deviceEvent(it.value().data(), Event::deviceLeft);
 
+    m_otaSessions.remove(it.value()->ieeeAddress());
+    m_topology.removeNode(it.value()->networkAddress());
     m_devices->removeDevice(it.value());
     m_devices->storeDatabase();
 }
@@ -1576,6 +1940,8 @@ void ZigBee::zdoMessageReveived(quint16 networkAddress, quint16 clusterId, const
                     memcpy(&clusterId, clusterData.constData() + i * sizeof(clusterId) + 1, sizeof(clusterId));
                     endpoint->outClusters().append(qFromLittleEndian(clusterId));
                 }
+
+                endpoint->setDirty(true);
             }
 
             endpoint->setDescriptorReceived();
@@ -1627,21 +1993,37 @@ void ZigBee::zdoMessageReveived(quint16 networkAddress, quint16 clusterId, const
                 if (!response->index)
                 {
                     logInfo << "Device" << device->name() << "neighbors list received";
+                    m_neighborsList.insert(device->ieeeAddress(), device->neighbors().keys());
                     device->neighbors().clear();
                 }
 
                 for (quint8 i = 0; i < response->count; i++)
                 {
                     const neighborRecordStruct *neighbor = reinterpret_cast <const neighborRecordStruct*> (payload.constData() + sizeof(lqiResponseStruct) + i * sizeof(neighborRecordStruct));
+                    quint8 relationship = (neighbor->options >> 4) & 0x07;
+
                     device->neighbors().insert(qFromLittleEndian(neighbor->networkAddress), neighbor->linkQuality);
+                    m_topology.updateLink(device->networkAddress(), qFromLittleEndian(neighbor->networkAddress), neighbor->linkQuality, relationship <= static_cast <quint8> (Relationship::PreviousChild) ? static_cast <Relationship> (relationship) : Relationship::None);
                 }
 
+                device->setDirty(true);
+
                 if (response->total > response->index + response->count)
                 {
                     device->setLqiRequestIndex(response->index + response->count);
                     enqueueRequest(device, RequestType::LQI);
+                    break;
                 }
 
+                m_topology.updateNeighbors(device->networkAddress(), device->neighbors().keys());
+
+                if (m_neighborsList.take(device->ieeeAddress()) != device->neighbors().keys())
+                    m_neighborsInterval.insert(device->ieeeAddress(), qMax(m_neighborsInterval.value(device->ieeeAddress(), UPDATE_NEIGHBORS_INTERVAL) / 2, UPDATE_NEIGHBORS_INTERVAL / 4));
+                else if (m_topology.linkHealth(device->networkAddress()) >= LINK_HEALTH_THRESHOLD)
+                    m_neighborsInterval.insert(device->ieeeAddress(), qMin(m_neighborsInterval.value(device->ieeeAddress(), UPDATE_NEIGHBORS_INTERVAL) * 2, UPDATE_NEIGHBORS_INTERVAL * 4));
+                else
+                    m_neighborsInterval.insert(device->ieeeAddress(), qMin(m_neighborsInterval.value(device->ieeeAddress(), UPDATE_NEIGHBORS_INTERVAL), UPDATE_NEIGHBORS_INTERVAL));
+
                 break;
             }
 
@@ -1656,64 +2038,49 @@ void ZigBee::zdoMessageReveived(quint16 networkAddress, quint16 clusterId, const
     }
 
     device->updateLastSeen();
+    emit deviceSeen(device.data());
 }
 
 void ZigBee::zclMessageReveived(quint16 networkAddress, quint8 endpointId, quint16 clusterId, quint8 linkQuality, const QByteArray &payload)
 {
     Device device = m_devices->byNetwork(networkAddress);
+    ZclFrame frame(payload);
     Endpoint endpoint;
-    quint16 manufacturerCode = 0;
-    quint8 frameControl = static_cast <quint8> (payload.at(0)), transactionId, commandId;
-    QByteArray data;
     Request request;
 
-    if (device.isNull() || device->removed() || !device->active())
+    if (device.isNull() || device->removed() || !device->active() || !frame.valid())
         return;
 
     device->setLinkQuality(linkQuality);
+    m_topology.updateLinkQuality(networkAddress, linkQuality);
     endpoint = m_devices->endpoint(device, endpointId);
     blink(50);
 
-    if (frameControl & FC_MANUFACTURER_SPECIFIC)
-    {
-        memcpy(&manufacturerCode, payload.constData() + 1, sizeof(manufacturerCode));
-        manufacturerCode = qFromLittleEndian(manufacturerCode);
-        transactionId = static_cast <quint8> (payload.at(3));
-        commandId = static_cast <quint8> (payload.at(4));
-        data = payload.mid(5);
-    }
-    else
-    {
-        transactionId = static_cast <quint8> (payload.at(1));
-        commandId = static_cast <quint8> (payload.at(2));
-        data = payload.mid(3);
-    }
-
-    request = m_requests.value(transactionId);
+    request = m_requests.value(frame.transactionId());
 
     if (!request.isNull() && request->type() == RequestType::Data && qvariant_cast <DataRequest> (request->data())->debug())
     {
-        QJsonObject json = {{"endpointId", endpointId}, {"clusterId", clusterId}, {"commandId", commandId}, {"payload", data.toHex(':').constData()}};
+        QJsonObject json = {{"endpointId", endpointId}, {"clusterId", clusterId}, {"commandId", frame.commandId()}, {"payload", frame.payload().toHex(':').constData()}};
 
-        if (manufacturerCode)
-            json.insert("manufacturerCode", manufacturerCode);
+        if (frame.manufacturerCode())
+            json.insert("manufacturerCode", frame.manufacturerCode());
 
-        emit deviceEvent(device.data(), frameControl & FC_CLUSTER_SPECIFIC ? Event::clusterRequest : Event::globalRequest, json);
+        emit deviceEvent(device.data(), frame.frameControl() & FC_CLUSTER_SPECIFIC ? Event::clusterRequest : Event::globalRequest, json);
     }
 
-    if (frameControl & FC_CLUSTER_SPECIFIC)
-        clusterCommandReceived(endpoint, clusterId, manufacturerCode, transactionId, commandId, data);
+    if (frame.frameControl() & FC_CLUSTER_SPECIFIC)
+        clusterCommandReceived(endpoint, clusterId, frame);
     else
-        globalCommandReceived(endpoint, clusterId, manufacturerCode, transactionId, commandId, data);
+        globalCommandReceived(endpoint, clusterId, frame);
 
-    if (device->interviewFinished() && (frameControl & FC_CLUSTER_SPECIFIC || commandId == CMD_REPORT_ATTRIBUTES) && !(frameControl & FC_DISABLE_DEFAULT_RESPONSE))
+    if (device->interviewFinished() && (frame.frameControl() & FC_CLUSTER_SPECIFIC || frame.commandId() == CMD_REPORT_ATTRIBUTES) && !(frame.frameControl() & FC_DISABLE_DEFAULT_RESPONSE))
     {
         defaultResponseStruct response;
 
-        response.commandId = commandId;
+        response.commandId = frame.commandId();
         response.status = 0x00;
 
-        enqueueRequest(device, endpoint->id(), clusterId, zclHeader(FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, transactionId, CMD_DEFAULT_RESPONSE, manufacturerCode).append(QByteArray(reinterpret_cast <char*> (&response), sizeof(response))));
+        enqueueRequest(device, endpoint->id(), clusterId, zclHeader(FC_SERVER_TO_CLIENT | FC_DISABLE_DEFAULT_RESPONSE, frame.transactionId(), CMD_DEFAULT_RESPONSE, frame.manufacturerCode()).append(QByteArray(reinterpret_cast <char*> (&response), sizeof(response))));
     }
 
     if (endpoint->updated())
@@ -1723,6 +2090,7 @@ void ZigBee::zclMessageReveived(quint16 networkAddress, quint8 endpointId, quint
     }
 
     device->updateLastSeen();
+    emit deviceSeen(device.data());
 }
 
 void ZigBee::rawMessageReveived(const QByteArray &ieeeAddress, quint16 clusterId, quint8 linkQuality, const QByteArray &data)
@@ -1761,6 +2129,21 @@ void ZigBee::requestFinished(quint8 id, quint8 status)
 
             if (status)
             {
+                if ((status == STATUS_NWK_NO_ROUTE || status == STATUS_MAC_NO_ACK) && !request->retry())
+                {
+                    DataRequest retry(new DataRequestObject(request->device(), request->endpointId(), request->clusterId(), request->data(), request->name(), request->debug(), request->manufacturerCode(), request->attributes()));
+                    Request item(new RequestObject(QVariant::fromValue(retry), RequestType::Data));
+
+                    logWarning << "Device" << request->device()->name() << (!request->name().isEmpty() ? request->name().toUtf8().constData() : "data request") << "failed, status code:" << QString::asprintf("0x%02x", status) << "retrying in" << REQUEST_RETRY_DELAY << "ms";
+                    m_topology.removeRoute(request->device()->networkAddress());
+
+                    retry->setRetry(true);
+                    item->setTime(QDateTime::currentMSecsSinceEpoch() + REQUEST_RETRY_DELAY);
+                    it.value()->setStatus(RequestStatus::Finished);
+                    insertRequest(request->device(), item);
+                    return;
+                }
+
                 logWarning << "Device" << request->device()->name() << (!request->name().isEmpty() ? request->name().toUtf8().constData() : "data request") << "failed, status code:" << QString::asprintf("0x%02x", status);
                 break;
             }
@@ -1787,6 +2170,8 @@ void ZigBee::requestFinished(quint8 id, quint8 status)
             logInfo << "Device" << device->name() << "removed";
             emit deviceEvent(device.data(), Event::deviceRemoved);
 
+            m_otaSessions.remove(device->ieeeAddress());
+            m_topology.removeNode(device->networkAddress());
             m_devices->removeDevice(device);
             m_devices->storeDatabase();
             break;
@@ -1799,13 +2184,31 @@ void ZigBee::requestFinished(quint8 id, quint8 status)
     it.value()->setStatus(RequestStatus::Finished);
 }
 
+void ZigBee::routeReceived(quint16 networkAddress, const QList <quint16> &relays)
+{
+    Device device = m_devices->byNetwork(networkAddress);
+
+    if (!m_topology.updateRoute(networkAddress, relays) || device.isNull() || !m_debug)
+        return;
+
+    logInfo << "Device" << device->name() << "route changed, hops:" << relays.count() + 1;
+}
+
 void ZigBee::handleRequests(void)
 {
+    qint64 time = QDateTime::currentMSecsSinceEpoch(), delay = 0;
+
     for (auto it = m_requests.begin(); it != m_requests.end(); it++)
     {
         if (it.value()->status() != RequestStatus::Pending)
             continue;
 
+        if (it.value()->time() > time)
+        {
+            delay = delay ? qMin(delay, it.value()->time() - time) : it.value()->time() - time;
+            continue;
+        }
+
         switch (it.value()->type())
         {
             case RequestType::Data:
@@ -1868,6 +2271,7 @@ void ZigBee::handleRequests(void)
             continue;
 
         it.value()->setStatus(RequestStatus::Sent);
+        it.value()->setSentTime(time);
     }
 
     for (auto it = m_requests.begin(); it != m_requests.end(); it++)
@@ -1879,32 +2283,86 @@ void ZigBee::handleRequests(void)
             break;
     }
 
+    if (delay)
+    {
+        m_requestTimer->start(static_cast <int> (delay));
+        return;
+    }
+
     m_requestTimer->stop();
 }
 
 void ZigBee::updateNeighbors(void)
 {
+    qint64 time = QDateTime::currentMSecsSinceEpoch(), interval;
+    Device device;
+
+    for (auto it = m_requests.begin(); it != m_requests.end(); it++)
+        if (it.value()->status() == RequestStatus::Pending || (it.value()->type() == RequestType::LQI && it.value()->status() == RequestStatus::Sent && time - it.value()->sentTime() <= REQUEST_QUEUE_TIMEOUT))
+            return;
+
     for (auto it = m_devices->begin(); it != m_devices->end(); it++)
     {
         if (it.value()->removed() || !it.value()->active() || it.value()->logicalType() == LogicalType::EndDevice)
             continue;
 
-        it.value()->setLqiRequestIndex(0);
-        enqueueRequest(it.value(), RequestType::LQI);
+        if (!m_neighborsTime.contains(it.key()))
+        {
+            m_neighborsTime.insert(it.key(), time + QRandomGenerator::global()->bounded(UPDATE_NEIGHBORS_INTERVAL));
+            continue;
+        }
+
+        if (m_neighborsTime.value(it.key()) > time)
+            continue;
+
+        if (!device.isNull())
+        {
+            quint32 hops = static_cast <quint32> (m_topology.hops(it.value()->networkAddress())), deviceHops = static_cast <quint32> (m_topology.hops(device->networkAddress()));
+
+            if (hops > deviceHops || (hops == deviceHops && m_neighborsTime.value(device->ieeeAddress()) <= m_neighborsTime.value(it.key())))
+                continue;
+        }
+
+        device = it.value();
     }
+
+    if (device.isNull())
+        return;
+
+    interval = m_neighborsInterval.value(device->ieeeAddress(), UPDATE_NEIGHBORS_INTERVAL);
+    m_neighborsTime.insert(device->ieeeAddress(), time + interval - interval / 10 + QRandomGenerator::global()->bounded(static_cast <int> (interval / 5)));
+
+    device->setLqiRequestIndex(0);
+    enqueueRequest(device, RequestType::LQI);
 }
 
 void ZigBee::pingDevices(void)
 {
     qint64 time = QDateTime::currentSecsSinceEpoch();
+    QMultiMap <quint8, Device> list;
+    int count = 0, index = 0;
 
     for (auto it = m_devices->begin(); it != m_devices->end(); it++)
     {
         const Device &device = it.value();
 
-        if (it.value()->removed() || !device->active() || it.value()->batteryPowered() || time - device->lastSeen() < PING_DEVICES_INTERVAL / 1000)
+        if (it.value()->removed() || !device->active() || it.value()->batteryPowered())
+            continue;
+
+        count++;
+
+        if (time - device->lastSeen() < PING_DEVICES_INTERVAL / 1000 + qHash(device->ieeeAddress()) % (PING_DEVICES_INTERVAL / 5000) || time - m_pingTime.value(device->ieeeAddress()) < PING_DEVICES_INTERVAL / 1000)
             continue;
 
+        list.insert(m_topology.linkHealth(device->networkAddress()), device);
+    }
+
+    for (auto item = list.begin(); item != list.end() && index <= count * PING_SCAN_INTERVAL / PING_DEVICES_INTERVAL; item++, index++)
+    {
+        const Device &device = item.value();
+
+        m_pingTime.insert(device->ieeeAddress(), time);
+
         for (auto it = device->endpoints().begin(); it != device->endpoints().end(); it++)
         {
             if (it.value()->inClusters().contains(CLUSTER_BASIC))
@@ -1916,6 +2374,104 @@ void ZigBee::pingDevices(void)
     }
 }
 
+void ZigBee::otaStream(void)
+{
+    qint64 time = QDateTime::currentMSecsSinceEpoch();
+    QList <QByteArray> list;
+    bool check = false;
+
+    for (auto it = m_requests.begin(); it != m_requests.end(); it++)
+    {
+        if (it.value()->type() != RequestType::Data || it.value()->status() != RequestStatus::Pending)
+            continue;
+
+        const DataRequest &request = qvariant_cast <DataRequest> (it.value()->data());
+
+        if (request->clusterId() != CLUSTER_OTA_UPGRADE)
+            continue;
+
+        list.append(request->device()->ieeeAddress());
+    }
+
+    for (auto it = m_otaSessions.begin(); it != m_otaSessions.end(); )
+    {
+        Device device = m_devices->value(it.key());
+
+        if (!it.value()->expired(time))
+        {
+            it++;
+            continue;
+        }
+
+        logWarning << "Device" << (device.isNull() ? it.key().toHex(':') : device->name()) << "OTA upgrade session expired";
+        it = m_otaSessions.erase(it);
+    }
+
+    for (auto it = m_otaSessions.begin(); it != m_otaSessions.end(); it++)
+    {
+        const OtaSession &session = it.value();
+        Device device = m_devices->value(it.key());
+        Endpoint endpoint;
+
+        if (!session->pageActive())
+            continue;
+
+        check = true;
+
+        if (time < session->pageTime() || list.contains(it.key()))
+            continue;
+
+        if (!device.isNull())
+        {
+            if (!otaBudget(device))
+                continue;
+
+            endpoint = device->endpoints().value(session->pageEndpointId());
+        }
+
+        if (endpoint.isNull())
+        {
+            session->advancePage(0);
+            continue;
+        }
+
+        session->advancePage(otaImageBlock(endpoint, session, session->pageTransactionId(), session->pageRequest().manufacturerCode, session->pageRequest().imageType, session->pageRequest().fileVersion, session->pageOffset(), session->pageRequest().maxDataSize));
+    }
+
+    if (check)
+        return;
+
+    if (!m_otaSessions.isEmpty())
+    {
+        if (m_otaTimer->interval() != OTA_EXPIRE_INTERVAL)
+            m_otaTimer->start(OTA_EXPIRE_INTERVAL);
+
+        return;
+    }
+
+    m_otaTimer->stop();
+}
+
+void ZigBee::otaImageChanged(const QString &fileName)
+{
+    m_otaImages.remove(fileName);
+    m_otaWatcher->removePath(fileName);
+
+    for (auto it = m_otaSessions.begin(); it != m_otaSessions.end(); )
+    {
+        Device device = m_devices->value(it.key());
+
+        if (it.value()->image()->fileName() != fileName)
+        {
+            it++;
+            continue;
+        }
+
+        logWarning << "Device" << (device.isNull() ? it.key().toHex(':') : device->name()) << "OTA upgrade aborted, image file" << fileName << "changed";
+        it = m_otaSessions.erase(it);
+    }
+}
+
 void ZigBee::interviewTimeout(void)
 {
     Device device = m_devices->value(reinterpret_cast <DeviceObject*> (sender()->parent())->ieeeAddress());
@@ -1931,6 +2487,19 @@ void ZigBee::pollRequest(EndpointObject *endpoint, const Poll &poll)
     enqueueRequest(endpoint->device(), endpoint->id(), poll->clusterId(), readAttributesRequest(m_requestId, 0x0000, poll->attributes()));
 }
 
+void ZigBee::updateStatus(const QJsonObject &json)
+{
+    QJsonObject status = json;
+    int pending = 0;
+
+    for (auto it = m_requests.begin(); it != m_requests.end(); it++)
+        if (it.value()->status() == RequestStatus::Pending)
+            pending++;
+
+    status.insert("requests", QJsonObject {{"queued", m_requests.count()}, {"pending", pending}, {"dropped", static_cast <qint64> (m_requestsDropped)}, {"rejected", static_cast <qint64> (m_requestsRejected)}, {"coalesced", static_cast <qint64> (m_requestsCoalesced)}});
+    emit statusUpdated(status);
+}
+
 void ZigBee::updateStatusLed(void)
 {
     GPIO::setStatus(m_statusLedPin, !GPIO::getStatus(m_statusLedPin));
@@ -2,11 +2,20 @@
 #define ZIGBEE_H
 
 #define UPDATE_NEIGHBORS_INTERVAL       3600000
+#define NEIGHBORS_SCAN_INTERVAL         10000
 #define PING_DEVICES_INTERVAL           300000
+#define PING_SCAN_INTERVAL              5000
 #define NETWORK_REQUEST_TIMEOUT         10000
+#define REQUEST_QUEUE_TIMEOUT           60000
+#define REQUEST_RETRY_DELAY             1000
 #define DEVICE_REJOIN_TIMEOUT           5000
 #define DEVICE_INTERVIEW_TIMEOUT        10000
 #define INTER_PAN_CHANNEL_TIMEOUT       100
+#define OTA_STREAM_INTERVAL             20
+#define OTA_BACKOFF_INTERVAL            1000
+#define OTA_BACKOFF_LIMIT               16
+#define OTA_WAIT_DELAY                  1
+#define OTA_EXPIRE_INTERVAL             60000
 #define STATUS_LED_TIMEOUT              500
 
 #define TIME_OFFSET                     946684800
@@ -14,6 +23,14 @@
 
 #include <QMetaEnum>
 #include "device.h"
+#include "ota.h"
+#include "topology.h"
+
+struct otaBudgetStruct
+{
+    double tokens;
+    qint64 time;
+};
 
 class DataRequestObject;
 typedef QSharedPointer <DataRequestObject> DataRequest;
@@ -43,7 +60,7 @@ class DataRequestObject
 public:
 
     DataRequestObject(const Device &device, quint8 endpointId, quint16 clusterId, const QByteArray &data, const QString &name, bool debug, quint16 manufacturerCode, const QList <quint16> attributes) :
-        m_device(device), m_endpointId(endpointId), m_clusterId(clusterId), m_data(data), m_name(name), m_debug(debug), m_manufacturerCode(manufacturerCode), m_attributes(attributes) {}
+        m_device(device), m_endpointId(endpointId), m_clusterId(clusterId), m_data(data), m_name(name), m_debug(debug), m_manufacturerCode(manufacturerCode), m_attributes(attributes), m_retry(false) {}
 
     inline Device device(void) { return m_device; }
     inline quint8 endpointId(void) { return m_endpointId; }
@@ -56,6 +73,9 @@ public:
     inline quint16 manufacturerCode(void) { return m_manufacturerCode; }
     inline QList <quint16> &attributes(void) { return m_attributes; }
 
+    inline bool retry(void) { return m_retry; }
+    inline void setRetry(bool value) { m_retry = value; }
+
 private:
 
     Device m_device;
@@ -69,6 +89,8 @@ private:
     quint16 m_manufacturerCode;
     QList <quint16> m_attributes;
 
+    bool m_retry;
+
 };
 
 class RequestObject
@@ -77,19 +99,25 @@ class RequestObject
 public:
 
     RequestObject(const QVariant &data, RequestType type) :
-        m_data(data), m_type(type), m_status(RequestStatus::Pending) {}
+        m_data(data), m_type(type), m_status(RequestStatus::Pending), m_time(QDateTime::currentMSecsSinceEpoch()), m_sentTime(0) {}
 
     inline QVariant data(void) { return m_data; }
     inline RequestType type(void) { return m_type; }
+    inline qint64 time(void) { return m_time; }
+    inline void setTime(qint64 value) { m_time = value; }
 
     inline RequestStatus status(void) { return m_status; }
     inline void setStatus(RequestStatus value) { m_status = value; }
 
+    inline qint64 sentTime(void) { return m_sentTime; }
+    inline void setSentTime(qint64 value) { m_sentTime = value; }
+
 private:
 
     QVariant m_data;
     RequestType m_type;
     RequestStatus m_status;
+    qint64 m_time, m_sentTime;
 
 };
 
@@ -115,12 +143,15 @@ public:
         interviewTimeout,
         clusterRequest,
         globalRequest,
-        requestFinished
+        requestFinished,
+        requestRejected,
+        otaUpgradeProgress
     };
 
     Q_ENUM(Event)
 
     inline DeviceList *devices(void) { return m_devices; }
+    inline Topology *topology(void) { return &m_topology; }
     inline const char *eventName(Event event) { return m_events.valueToKey(static_cast <int> (event)); }
 
     void init(void);
@@ -144,12 +175,13 @@ public:
     void touchLinkRequest(const QByteArray &ieeeAddress = QByteArray(), quint8 channel = 11, bool reset = false);
 
     void deviceAction(const QString &deviceName, quint8 endpointId, const QString &name, const QVariant &data);
+    void deviceActions(const QList <QVariant> &list);
     void groupAction(quint16 groupId, const QString &name, const QVariant &data);
 
 private:
 
     QSettings *m_config;
-    QTimer *m_requestTimer, *m_neignborsTimer, *m_pingTimer, *m_statusLedTimer;
+    QTimer *m_requestTimer, *m_neignborsTimer, *m_pingTimer, *m_otaTimer, *m_statusLedTimer;
 
     Adapter *m_adapter;
     DeviceList *m_devices;
@@ -161,14 +193,34 @@ private:
     QString m_statusLedPin, m_blinkLedPin;
     bool m_discovery, m_cloud, m_debug;
 
-    Device m_otaDevice;
-    QFile m_otaFile;
-    bool m_otaForce;
+    OtaRepository *m_otaRepository;
+    QFileSystemWatcher *m_otaWatcher;
+    QMap <QString, QWeakPointer <OtaImageObject>> m_otaImages;
+    QMap <QByteArray, OtaSession> m_otaSessions;
+
+    double m_otaBlockRate, m_otaRouteBlockRate;
+    quint16 m_otaMinimumBlockPeriod;
+    otaBudgetStruct m_otaBudget;
+    QMap <quint16, otaBudgetStruct> m_otaRouteBudget;
+    qint64 m_otaBackoffTime;
+    int m_otaBackoff;
 
     QMap <quint8, Request> m_requests;
 
+    Topology m_topology;
+    QMap <QByteArray, qint64> m_neighborsTime, m_neighborsInterval, m_pingTime;
+    QMap <QByteArray, QList <quint16>> m_neighborsList;
+    int m_queueLimit, m_deviceQueueLimit;
+    bool m_queueReject;
+    quint32 m_requestsDropped, m_requestsRejected, m_requestsCoalesced;
+
     void enqueueRequest(const Device &device, quint8 endpointId, quint16 clusterId, const QByteArray &data, const QString &name = QString(), bool debug = false, quint16 manufacturerCode = 0, const QList <quint16> &attributes = {});
     void enqueueRequest(const Device &device, RequestType type);
+    void insertRequest(const Device &device, const Request &request);
+    bool coalesceRequest(const DataRequest &request, const DataRequest &other);
+    Device requestDevice(const Request &request);
+
+    void deviceAction(const Device &device, quint8 endpointId, const QString &name, const QVariant &data);
 
     bool interviewRequest(quint8 id, const Device &device);
     bool interviewQuirks(const Device &device);
@@ -181,8 +233,8 @@ private:
     bool configureDevice(const Device &device);
 
     void parseAttribute(const Endpoint &endpoint, quint16 clusterId, quint8 transactionId, quint16 attributeId, quint8 dataType, const QByteArray &data);
-    void clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId, quint16 manufacturerCode, quint8 transactionId, quint8 commandId, const QByteArray &payload);
-    void globalCommandReceived(const Endpoint &endpoint, quint16 clusterId, quint16 manufacturerCode, quint8 transactionId, quint8 commandId, QByteArray payload);
+    void clusterCommandReceived(const Endpoint &endpoint, quint16 clusterId, const ZclFrame &frame);
+    void globalCommandReceived(const Endpoint &endpoint, quint16 clusterId, const ZclFrame &frame);
 
     void touchLinkReset(const QByteArray &ieeeAddress, quint8 channel);
     void touchLinkScan(void);
@@ -190,6 +242,11 @@ private:
     void interviewTimeoutHandler(const Device &device);
     void rejoinHandler(const Device &device);
 
+    OtaImage otaImage(const QString &fileName);
+    int otaImageBlock(const Endpoint &endpoint, const OtaSession &session, quint8 transactionId, quint16 manufacturerCode, quint16 imageType, quint32 fileVersion, quint32 fileOffset, quint8 maxDataSize);
+    quint16 otaBlockPeriod(void);
+    bool otaBudget(const Device &device);
+    void otaWait(const Endpoint &endpoint, quint8 transactionId, quint32 delay, quint16 minimumBlockPeriod);
     void otaError(const Endpoint &endpoint, quint16 manufacturerCode, quint8 transactionId, quint8 commandId, const QString &error = QString());
     void blink(quint16 timeout);
 
@@ -205,14 +262,18 @@ private slots:
     void zclMessageReveived(quint16 networkAddress, quint8 endpointId, quint16 clusterId, quint8 linkQuality, const QByteArray &payload);
     void rawMessageReveived(const QByteArray &ieeeAddress, quint16 clusterId, quint8 linkQuality, const QByteArray &data);
     void requestFinished(quint8 id, quint8 status);
+    void routeReceived(quint16 networkAddress, const QList <quint16> &relays);
 
     void handleRequests(void);
     void updateNeighbors(void);
     void pingDevices(void);
+    void otaStream(void);
+    void otaImageChanged(const QString &fileName);
     void interviewTimeout(void);
 
     void pollRequest(EndpointObject *endpoint, const Poll &poll);
 
+    void updateStatus(const QJsonObject &json);
     void updateStatusLed(void);
     void updateBlinkLed(void);
 
@@ -221,6 +282,7 @@ signals:
     void networkStarted(void);
     void deviceEvent(DeviceObject *device, ZigBee::Event event, const QJsonObject &json = QJsonObject());
     void endpointUpdated(DeviceObject *device, quint8 endpointId);
+    void deviceSeen(DeviceObject *device);
     void statusUpdated(const QJsonObject &json);
     void replyReceived(void);
 
@@ -154,7 +154,6 @@ void ZStack::parsePacket(quint16 command, const QByteArray &data)
         case ZDO_MGMT_LEAVE_RSP:
         case ZDO_MGMT_PERMIT_JOIN_RSP:
         case ZDO_MGMT_NWK_UPDATE_RSP:
-        case ZDO_SRC_RTG_IND:
         case ZDO_CONCENTRATOR_IND:
         case ZDO_TC_DEV_IND:
         case ZDO_PERMIT_JOIN_IND:
@@ -218,6 +217,21 @@ void ZStack::parsePacket(quint16 command, const QByteArray &data)
             break;
         }
 
+        case ZDO_SRC_RTG_IND:
+        {
+            const sourceRouteStruct *message = reinterpret_cast <const sourceRouteStruct*> (data.constData());
+            QList <quint16> relays;
+
+            if (data.length() < static_cast <int> (sizeof(sourceRouteStruct)) || data.length() < static_cast <int> (sizeof(sourceRouteStruct) + message->relayCount * sizeof(quint16)))
+                break;
+
+            for (quint8 i = 0; i < message->relayCount; i++)
+                relays.append(qFromLittleEndian <quint16> (reinterpret_cast <const uchar*> (data.constData() + sizeof(sourceRouteStruct) + i * sizeof(quint16))));
+
+            emit routeReceived(qFromLittleEndian(message->dstAddress), relays);
+            break;
+        }
+
         case ZDO_LEAVE_IND:
         {
             const deviceLeaveStruct *message = reinterpret_cast <const deviceLeaveStruct*> (data.constData());
@@ -234,6 +234,12 @@ struct deviceLeaveStruct
     quint8  rejoin;
 };
 
+struct sourceRouteStruct
+{
+    quint16 dstAddress;
+    quint8  relayCount;
+};
+
 struct zdoMessageStruct
 {
     quint16 srcAddress;